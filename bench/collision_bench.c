@@ -0,0 +1,145 @@
+// Collision microbenchmark: a synthetic 2,000-wall level, queried through the level grid
+// (Gameplay_CircleHitsWall, Gameplay_GetRayHit) and through the per-wall loops they replaced.
+// Build and run with `make bench` (add SIMD=-mavx2 to time the AVX kernel).
+#include "../src/gameplay_helpers.h"
+#include <stdio.h>
+#include <time.h>
+
+#define BENCH_WALLS 2000
+#define BENCH_MAP_SIZE 8000.0f
+#define BENCH_CIRCLES 20000
+#define BENCH_RAYS 5000
+#define BENCH_RAY_LENGTH 600.0f
+
+static Level level;
+static Vector2 circleCenters[BENCH_CIRCLES];
+static float circleRadii[BENCH_CIRCLES];
+static Vector2 rayStarts[BENCH_RAYS];
+static Vector2 rayEnds[BENCH_RAYS];
+
+// Fixed LCG so every run (and every build) measures the same level
+static unsigned int seed = 12345u;
+static float RandomFloat(float min, float max) {
+    seed = seed * 1664525u + 1013904223u;
+    return min + (max - min) * (float)(seed >> 8) / (float)(1u << 24);
+}
+
+static double Now(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// The loop UpdatePlayer, MoveEnemyWithCollision and the bullet update used to run
+static bool LinearCircleHitsWall(const Level *level, Vector2 center, float radius) {
+    for (int w = 0; w < level->wallCount; w++) {
+        if (CheckCollisionCircleRotatedRect(center, radius, level->walls[w].rect, level->walls[w].rotation)) return true;
+    }
+    return false;
+}
+
+// The old Gameplay_GetRayHit: every edge of every wall, in the wall's local space
+static Vector2 LinearRayHit(Vector2 start, Vector2 end, const Level *level) {
+    Vector2 closestHit = end;
+    float closestDistSq = Vector2DistanceSqr(start, end);
+    for (int i = 0; i < level->wallCount; i++) {
+        Wall w = level->walls[i];
+        Vector2 origin = { w.rect.x + w.rect.width/2.0f, w.rect.y + w.rect.height/2.0f };
+        float c = cosf(-w.rotation * DEG2RAD);
+        float s = sinf(-w.rotation * DEG2RAD);
+        Vector2 dS = Vector2Subtract(start, origin);
+        Vector2 dE = Vector2Subtract(end, origin);
+        Vector2 localStart = { dS.x * c - dS.y * s, dS.x * s + dS.y * c };
+        Vector2 localEnd = { dE.x * c - dE.y * s, dE.x * s + dE.y * c };
+
+        float hw = w.rect.width/2.0f;
+        float hh = w.rect.height/2.0f;
+        Vector2 corners[4] = { { -hw, -hh }, { hw, -hh }, { hw, hh }, { -hw, hh } };
+        for (int e = 0; e < 4; e++) {
+            Vector2 hit;
+            if (!CheckCollisionLines(localStart, localEnd, corners[e], corners[(e + 1) % 4], &hit)) continue;
+            float d2 = Vector2DistanceSqr(localStart, hit);
+            if (d2 < closestDistSq) {
+                closestDistSq = d2;
+                float c2 = cosf(w.rotation * DEG2RAD);
+                float s2 = sinf(w.rotation * DEG2RAD);
+                closestHit.x = origin.x + (hit.x * c2 - hit.y * s2);
+                closestHit.y = origin.y + (hit.x * s2 + hit.y * c2);
+            }
+        }
+    }
+    return closestHit;
+}
+
+static bool BuildLevel(void) {
+    if (!Level_ResizeWalls(&level, BENCH_WALLS)) return false;
+    for (int i = 0; i < BENCH_WALLS; i++) {
+        Wall *w = &level.walls[i];
+        w->rect = (Rectangle){ RandomFloat(0.0f, BENCH_MAP_SIZE), RandomFloat(0.0f, BENCH_MAP_SIZE),
+                               RandomFloat(20.0f, 200.0f), RandomFloat(10.0f, 30.0f) };
+        // Mostly axis-aligned like the episodes, a quarter truly rotated
+        if (i % 4 == 3) w->rotation = RandomFloat(0.0f, 180.0f);
+        else w->rotation = (i % 2) ? 90.0f : 0.0f;
+    }
+    return Level_BuildCollision(&level);
+}
+
+int main(void) {
+    SetTraceLogLevel(LOG_WARNING);
+    if (!BuildLevel()) {
+        printf("out of memory building the level\n");
+        return 1;
+    }
+    for (int i = 0; i < BENCH_CIRCLES; i++) {
+        circleCenters[i] = (Vector2){ RandomFloat(0.0f, BENCH_MAP_SIZE), RandomFloat(0.0f, BENCH_MAP_SIZE) };
+        circleRadii[i] = RandomFloat(5.0f, 20.0f);
+    }
+    for (int i = 0; i < BENCH_RAYS; i++) {
+        rayStarts[i] = (Vector2){ RandomFloat(0.0f, BENCH_MAP_SIZE), RandomFloat(0.0f, BENCH_MAP_SIZE) };
+        float angle = RandomFloat(0.0f, 2.0f * PI);
+        rayEnds[i] = Vector2Add(rayStarts[i], (Vector2){ cosf(angle) * BENCH_RAY_LENGTH, sinf(angle) * BENCH_RAY_LENGTH });
+    }
+
+    int mismatches = 0;
+
+    int linearHits = 0, gridHits = 0;
+    double t0 = Now();
+    for (int i = 0; i < BENCH_CIRCLES; i++) linearHits += LinearCircleHitsWall(&level, circleCenters[i], circleRadii[i]);
+    double t1 = Now();
+    for (int i = 0; i < BENCH_CIRCLES; i++) gridHits += Gameplay_CircleHitsWall(&level, circleCenters[i], circleRadii[i]);
+    double t2 = Now();
+    for (int i = 0; i < BENCH_CIRCLES; i++) {
+        if (LinearCircleHitsWall(&level, circleCenters[i], circleRadii[i]) != Gameplay_CircleHitsWall(&level, circleCenters[i], circleRadii[i])) mismatches++;
+    }
+    printf("circle vs walls (%d walls, %d queries, %d hits)\n", level.wallCount, BENCH_CIRCLES, gridHits);
+    printf("  per-wall loop          %8.3f us/query\n", (t1 - t0) * 1e6 / BENCH_CIRCLES);
+    printf("  Gameplay_CircleHitsWall %7.3f us/query  (x%.1f)\n", (t2 - t1) * 1e6 / BENCH_CIRCLES, (t1 - t0) / (t2 - t1));
+    if (linearHits != gridHits) printf("  hit counts differ: %d vs %d\n", linearHits, gridHits);
+
+    float sink = 0.0f;
+    t0 = Now();
+    for (int i = 0; i < BENCH_RAYS; i++) sink += LinearRayHit(rayStarts[i], rayEnds[i], &level).x;
+    t1 = Now();
+    for (int i = 0; i < BENCH_RAYS; i++) sink += Gameplay_GetRayHit(rayStarts[i], rayEnds[i], &level).x;
+    t2 = Now();
+    int grazes = 0;
+    for (int i = 0; i < BENCH_RAYS; i++) {
+        Vector2 a = LinearRayHit(rayStarts[i], rayEnds[i], &level);
+        Vector2 b = Gameplay_GetRayHit(rayStarts[i], rayEnds[i], &level);
+        if (Vector2Distance(a, b) <= 0.01f) continue;
+        // The local-space edge tests can round away a ray that just touches a corner: a nearer
+        // hit on a wall outline is such a touch, anything else is a real difference
+        bool nearer = Vector2DistanceSqr(rayStarts[i], b) < Vector2DistanceSqr(rayStarts[i], a);
+        if (nearer && LinearCircleHitsWall(&level, b, 0.05f)) grazes++;
+        else mismatches++;
+    }
+    printf("ray vs walls (%d rays of %.0fpx)\n", BENCH_RAYS, BENCH_RAY_LENGTH);
+    printf("  per-wall loop          %8.3f us/ray\n", (t1 - t0) * 1e6 / BENCH_RAYS);
+    printf("  Gameplay_GetRayHit     %8.3f us/ray    (x%.1f)\n", (t2 - t1) * 1e6 / BENCH_RAYS, (t1 - t0) / (t2 - t1));
+
+    if (grazes) printf("  %d rays touch a corner the per-wall loop misses\n", grazes);
+
+    printf("%d mismatches (checksum %.1f)\n", mismatches, sink);
+    UnloadLevel(&level);
+    return mismatches ? 1 : 0;
+}
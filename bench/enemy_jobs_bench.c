@@ -0,0 +1,152 @@
+// Enemy AI on worker threads: plays each episode's enemies for a while with the player
+// circling the spawn, once with UpdateEnemies inline and once split over the job threads
+// the way the game splits it, and checks that both produce the same commands, in merge
+// order, every frame. Build and run with `make bench`.
+#include "../src/enemies/enemy.h"
+#include "../src/jobs.h"
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define BENCH_FRAMES 600
+#define BENCH_DT (1.0f / 60.0f)
+#define BENCH_MAX_COMMANDS 4096
+
+static Level level;
+static EnemyScheduler scheduler;
+static NavPath *paths;
+static EnemyCommandBuffer commands[JOBS_MAX_WORKERS];
+static Pool bullets = POOL_INIT(Bullet, 0);
+static Vector2 playerPos;
+static atomic_int workerBatches; // Batches that ran off the main thread
+static const EnemyCommand *merged[BENCH_MAX_COMMANDS];
+
+static double Now(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static void Hash(uint64_t *hash, const void *data, size_t size) {
+    const unsigned char *bytes = data;
+    for (size_t i = 0; i < size; i++) {
+        *hash ^= bytes[i];
+        *hash *= 1099511628211ull;
+    }
+}
+
+static void ThinkEnemies(void *ctx, int begin, int end, int worker) {
+    (void)ctx;
+    if (worker != 0) atomic_fetch_add(&workerBatches, 1);
+    UpdateEnemies(&level, scheduler.enemies, paths, playerPos, &commands[worker], begin, end);
+}
+
+// Hashes this frame's commands in the order EnemyCommands_Apply runs them: by enemy, an
+// enemy's own in the order it pushed them (they all sit in one buffer)
+static void HashCommands(uint64_t *hash) {
+    int count = 0;
+    for (int b = 0; b < Jobs_WorkerCount(); b++) {
+        for (int i = 0; i < commands[b].count && count < BENCH_MAX_COMMANDS; i++) {
+            const EnemyCommand *command = &commands[b].items[i];
+            int j = count++;
+            while (j > 0 && merged[j - 1]->enemy > command->enemy) {
+                merged[j] = merged[j - 1];
+                j--;
+            }
+            merged[j] = command;
+        }
+    }
+    for (int i = 0; i < count; i++) {
+        const EnemyCommand *command = merged[i];
+        int path = command->path ? (int)(command->path - paths) : -1;
+        Hash(hash, &command->type, sizeof(command->type));
+        Hash(hash, &command->enemy, sizeof(command->enemy));
+        Hash(hash, &command->position, sizeof(command->position));
+        Hash(hash, &command->velocity, sizeof(command->velocity));
+        Hash(hash, &command->permission, sizeof(command->permission));
+        Hash(hash, &path, sizeof(path));
+    }
+    Hash(hash, &count, sizeof(count));
+}
+
+// Plays the episode from its start. Returns the hash of every frame's commands and the
+// final enemy states; *ms is the average time of the UpdateEnemies phase per frame.
+static uint64_t Play(int episode, bool threaded, double *ms) {
+    if (!InitLevel(episode, &level) || !EnemyScheduler_Reset(&scheduler, &level)) {
+        printf("episode %d: out of memory\n", episode);
+        exit(1);
+    }
+    free(paths);
+    paths = calloc((size_t)level.enemyCount + 1, sizeof(NavPath));
+    if (!paths) {
+        printf("episode %d: out of memory\n", episode);
+        exit(1);
+    }
+    Pool_Clear(&bullets);
+
+    uint64_t hash = 1469598103934665603ull;
+    double total = 0.0;
+    for (int frame = 0; frame < BENCH_FRAMES; frame++) {
+        playerPos.x = level.playerSpawn.x + 200.0f * cosf(frame * 0.02f);
+        playerPos.y = level.playerSpawn.y + 200.0f * sinf(frame * 0.02f);
+
+        EnemyScheduler_Plan(&scheduler, &level, playerPos, BENCH_DT);
+        for (int i = 0; i < level.enemyCount; i++) {
+            EnemySchedule *s = &scheduler.enemies[i];
+            if (s->perceive) s->seesPlayer = CheckLineOfSight(&level.enemyBodies[i], &level.enemyAI[i], playerPos, &level, NULL);
+        }
+
+        int count = level.enemyCount;
+        int batch = threaded ? Jobs_SplitBatch(count, ENEMY_JOB_MIN_BATCH) : count; // One batch runs inline
+        double start = Now();
+        Jobs_Run(ThinkEnemies, NULL, count, batch);
+        total += Now() - start;
+
+        HashCommands(&hash);
+        EnemyCommands_Apply(commands, Jobs_WorkerCount(), &bullets);
+        Nav_Update(&level);
+    }
+
+    for (int i = 0; i < level.enemyCount; i++) {
+        Hash(&hash, &level.enemyBodies[i].position, sizeof(Vector2));
+        Hash(&hash, &level.enemyAI[i].state, sizeof(level.enemyAI[i].state));
+    }
+    Hash(&hash, &bullets.count, sizeof(bullets.count));
+    *ms = total * 1e3 / BENCH_FRAMES;
+    return hash;
+}
+
+int main(void) {
+    SetTraceLogLevel(LOG_WARNING);
+    Jobs_Init();
+    printf("%d threads, at least %d enemies per batch\n", Jobs_WorkerCount(), ENEMY_JOB_MIN_BATCH);
+
+    int mismatches = 0;
+    for (int episode = 1; episode <= 4; episode++) {
+        double inlineMs, threadedMs;
+        uint64_t inlineHash = Play(episode, false, &inlineMs);
+        atomic_store(&workerBatches, 0);
+        uint64_t threadedHash = Play(episode, true, &threadedMs);
+        int offMain = atomic_load(&workerBatches);
+
+        bool same = (inlineHash == threadedHash);
+        if (!same) mismatches++;
+        printf("episode %d, %2d enemies: inline %.3f ms, threaded %.3f ms (batch %d, %d batches on workers)  %s\n",
+               episode, level.enemyCount, inlineMs, threadedMs,
+               Jobs_SplitBatch(level.enemyCount, ENEMY_JOB_MIN_BATCH), offMain, same ? "same commands" : "COMMANDS DIFFER");
+        if (Jobs_WorkerCount() > 1 && offMain == 0) {
+            printf("  no batch reached a worker thread\n");
+            mismatches++;
+        }
+    }
+
+    for (int i = 0; i < JOBS_MAX_WORKERS; i++) EnemyCommands_Free(&commands[i]);
+    Pool_Free(&bullets);
+    EnemyScheduler_Free(&scheduler);
+    free(paths);
+    UnloadLevel(&level);
+    Jobs_Shutdown();
+    return mismatches ? 1 : 0;
+}
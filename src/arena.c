@@ -0,0 +1,85 @@
+#include "arena.h"
+#include "../raylib/src/raylib.h"
+#include <stdalign.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ARENA_ALIGN alignof(max_align_t)
+
+struct ArenaBlock {
+    ArenaBlock *next;
+    size_t size; // Usable bytes after the header
+    size_t used;
+    size_t last; // Offset of the last allocation, for Arena_Realloc
+};
+
+static size_t AlignUp(size_t n) {
+    return (n + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+}
+
+static char *BlockData(ArenaBlock *block) {
+    return (char *)block + AlignUp(sizeof(ArenaBlock));
+}
+
+void *Arena_Alloc(Arena *arena, size_t size) {
+    size = AlignUp(size > 0 ? size : 1);
+    ArenaBlock *block = arena->blocks;
+    if (!block || block->size - block->used < size) {
+        size_t blockSize = (size > ARENA_BLOCK_SIZE) ? size : ARENA_BLOCK_SIZE;
+        block = (ArenaBlock *)malloc(AlignUp(sizeof(ArenaBlock)) + blockSize);
+        if (!block) {
+            TraceLog(LOG_WARNING, "Failed to allocate an arena block of %zu bytes", blockSize);
+            return NULL;
+        }
+        block->size = blockSize;
+        block->used = 0;
+        block->last = 0;
+
+        // Keep the current block in front if it has more room left than the new one will
+        if (arena->blocks && arena->blocks->size - arena->blocks->used > blockSize - size) {
+            block->next = arena->blocks->next;
+            arena->blocks->next = block;
+        } else {
+            block->next = arena->blocks;
+            arena->blocks = block;
+        }
+    }
+
+    char *items = BlockData(block) + block->used;
+    block->last = block->used;
+    block->used += size;
+    memset(items, 0, size);
+    return items;
+}
+
+void *Arena_Realloc(Arena *arena, void *items, size_t oldSize, size_t newSize) {
+    if (!items) return Arena_Alloc(arena, newSize);
+    if (newSize <= oldSize) return items;
+
+    // Last allocation of the current block: extend it where it is
+    ArenaBlock *block = arena->blocks;
+    if (block && (char *)items == BlockData(block) + block->last) {
+        size_t end = block->last + AlignUp(newSize);
+        if (end <= block->size) {
+            memset((char *)items + oldSize, 0, newSize - oldSize);
+            block->used = end;
+            return items;
+        }
+    }
+
+    char *grown = (char *)Arena_Alloc(arena, newSize);
+    if (!grown) return NULL;
+    memcpy(grown, items, oldSize);
+    return grown;
+}
+
+void Arena_Free(Arena *arena) {
+    ArenaBlock *block = arena->blocks;
+    while (block) {
+        ArenaBlock *next = block->next;
+        free(block);
+        block = next;
+    }
+    arena->blocks = NULL;
+}
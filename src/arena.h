@@ -0,0 +1,31 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+// Bump allocator for data that lives and dies together (a level's contents).
+// Memory comes from a chain of blocks; there is no per-allocation free, everything
+// goes at once with Arena_Free. Only what is handed out is zeroed, so an arena
+// costs what its data needs, not what a worst case would.
+
+#define ARENA_BLOCK_SIZE (64 * 1024) // Minimum block, bigger requests get a block of their own
+
+typedef struct ArenaBlock ArenaBlock;
+
+typedef struct {
+    ArenaBlock *blocks; // Current block first
+} Arena;
+
+// Returns `size` zeroed bytes aligned for any type (NULL if out of memory)
+void *Arena_Alloc(Arena *arena, size_t size);
+
+// Grows an allocation of `oldSize` bytes to `newSize`: in place if it was the last one
+// and still fits its block, otherwise into a new allocation (the old bytes stay
+// allocated until Arena_Free). The added bytes are zeroed. NULL if out of memory,
+// `items` is then left as it was.
+void *Arena_Realloc(Arena *arena, void *items, size_t oldSize, size_t newSize);
+
+// Frees every block, the arena stays usable (and empty)
+void Arena_Free(Arena *arena);
+
+#endif // ARENA_H
@@ -4,6 +4,7 @@
 #include "../raylib/src/rlgl.h"
 #include "enemies/enemy.h"
 #include "gameplay_helpers.h"
+#include "game.h"
 
 
 bool is_state_closed(EditorState state) { return state == ED_CLOSED; }
@@ -68,6 +69,15 @@ const char* EditorState_cstr(EditorState state) {
 }
 
 
+// Rebuilds collision after an edit. Out of memory leaves the edited walls and doors
+// without collision until the next edit succeeds, so say so.
+static void editor_build_collision(LevelEditor* ed) {
+    if (!Level_BuildCollision(ed->level)) {
+        TraceLog(LOG_WARNING, "editor: out of memory rebuilding collision, walls and doors don't collide");
+    }
+}
+
+
 LevelEditor LevelEditor_new(Level* level) {
     return (LevelEditor) {
         .level = level,
@@ -92,16 +102,17 @@ void editor_pick(LevelEditor* ed) {
     for (int i = 0; i < ed->level->enemyCount; i++) {
         Rectangle r = {0};
         int ext = 25;
-        r.x = ed->level->enemies[i].position.x - ext;
-        r.y = ed->level->enemies[i].position.y - ext;
+        r.x = ed->level->enemyBodies[i].position.x - ext;
+        r.y = ed->level->enemyBodies[i].position.y - ext;
         r.width  = 2*ext;
         r.height = 2*ext;
         if (CheckCollisionPointRec(ed->mouse_world, r)) {
             ed->state = ED_MOVE_ENEMY;
             ed->selected = i;
+            ed->selectedEnemy = Level_EnemyHandle(ed->level, i);
             ed->drag_offset = (Vector2){
-                ed->mouse_world.x - ed->level->enemies[i].position.x,
-                ed->mouse_world.y - ed->level->enemies[i].position.y
+                ed->mouse_world.x - ed->level->enemyBodies[i].position.x,
+                ed->mouse_world.y - ed->level->enemyBodies[i].position.y
             };
             return;
         }
@@ -189,6 +200,7 @@ void editor_update(LevelEditor* ed, Camera2D* camera) {
 
     Rectangle* target_rect = NULL;
     Rectangle enemy_dummy_rect = {0};
+    int enemy = -1;
     switch (ed->state) {
         case ED_MOVE_WALL:
         case ED_ROTATE_WALL:
@@ -200,13 +212,22 @@ void editor_update(LevelEditor* ed, Camera2D* camera) {
         case ED_MOVE_WA:
         case ED_SCALE_WA:     target_rect = &ed->level->win_area; break;
         case ED_MOVE_ENEMY: {
-            enemy_dummy_rect.x = ed->level->enemies[ed->selected].position.x;
-            enemy_dummy_rect.y = ed->level->enemies[ed->selected].position.y;
+            enemy = Level_ResolveEnemy(ed->level, ed->selectedEnemy);
+            if (enemy < 0) {
+                ed->state = ED_IDLE;
+                ed->selected = -1;
+                return;
+            }
+            enemy_dummy_rect.x = ed->level->enemyBodies[enemy].position.x;
+            enemy_dummy_rect.y = ed->level->enemyBodies[enemy].position.y;
             target_rect = &enemy_dummy_rect;
         } break;
         default: return;
     }
 
+    Rectangle rect_before = *target_rect;
+    float rotation_before = is_state_wall(ed->state) ? ed->level->walls[ed->selected].rotation : 0.0f;
+
     if (IsMouseButtonDown(MOUSE_LEFT_BUTTON)) {
         if (is_state_move(ed->state)) {
             target_rect->x = ed->mouse_world.x - ed->drag_offset.x;
@@ -244,8 +265,17 @@ void editor_update(LevelEditor* ed, Camera2D* camera) {
     // apply rect edit to enemy
     // because enemy does not have rect
     if (ed->state == ED_MOVE_ENEMY) {
-        ed->level->enemies[ed->selected].position.x = target_rect->x;
-        ed->level->enemies[ed->selected].position.y = target_rect->y;
+        ed->level->enemyBodies[enemy].position.x = target_rect->x;
+        ed->level->enemyBodies[enemy].position.y = target_rect->y;
+    }
+
+    // walls/doors feed the collision grid, keep it in sync with edits
+    if (is_state_wall(ed->state) || is_state_door(ed->state)) {
+        bool rect_changed = memcmp(&rect_before, target_rect, sizeof(Rectangle)) != 0;
+        bool rotation_changed = is_state_wall(ed->state) && rotation_before != ed->level->walls[ed->selected].rotation;
+        if (rect_changed || rotation_changed) {
+            editor_build_collision(ed);
+        }
     }
 
 }
@@ -286,7 +316,7 @@ void level_editor_export(LevelEditor* ed) {
 
     printf("// ---- LEVEL EDITOR EXPORT ----\n");
     printf("// ---- WALLS ----\n");
-    printf("level->wallCount = %d;\n", level->wallCount);
+    printf("if (!Level_ResizeWalls(level, %d)) return false;\n", level->wallCount);
     for (int i = 0; i < level->wallCount; i++) {
         Rectangle r = level->walls[i].rect;
         float rot = level->walls[i].rotation;
@@ -297,7 +327,7 @@ void level_editor_export(LevelEditor* ed) {
     }
 
     printf("\n// ---- BACKGROUNDS ----\n");
-    printf("level->bgs_count = %zu;\n", level->bgs_count);
+    printf("if (!Level_ResizeBackgrounds(level, %zu)) return false;\n", level->bgs_count);
     printf("static Texture2D level_bg_textures[%zu];\n", level->bgs_count);
     for (int i = 0; i < level->bgs_count; i++) {
         printf("if (0 == level_bg_textures[%d].id) level_bg_textures[%d] = LoadTexture(\"TEXTURE_PATH_HERE\");\n", i, i);
@@ -311,7 +341,7 @@ void level_editor_export(LevelEditor* ed) {
     }
 
     printf("\n// ---- DOORS ----\n");
-    printf("level->doorCount = %d;\n", level->doorCount);
+    printf("if (!Level_ResizeDoors(level, %d)) return false;\n", level->doorCount);
     for (int i = 0; i < level->doorCount; i++) {
         Door *d = &level->doors[i];
 
@@ -326,15 +356,16 @@ void level_editor_export(LevelEditor* ed) {
 
 
     printf("\n// ---- ENEMIES ----\n");
-    printf("level->enemyCount = %d;\n", level->enemyCount);
+    printf("if (!Level_ResizeEnemies(level, %d)) return false;\n", level->enemyCount);
     for (int i = 0; i < level->enemyCount; i++) {
-        Entity *e = &level->enemies[i];
+        const EntityBody *e = &level->enemyBodies[i];
+        EnemyType type = level->enemyStats[i].type;
 
-        printf("Identity enemy_id_%d = {.permissionLevel = %d, .color = PURPLE, .speed = 250.0f};\n", i, e->type);
-        printf("level->enemies[%d] = InitEnemy((Vector2){%f,%f}, %s);\n",
-            i, e->position.x, e->position.y, EnemyType_cstr(e->type)
+        printf("Identity enemy_id_%d = {.permissionLevel = %d, .color = PURPLE, .speed = 250.0f};\n", i, type);
+        printf("InitEnemy(level, %d, (Vector2){%f,%f}, %s);\n",
+            i, e->position.x, e->position.y, EnemyType_cstr(type)
         );
-        printf("level->enemies[%d].identity = enemy_id_%d;\n", i, i);
+        printf("level->enemyAI[%d].identity = enemy_id_%d;\n", i, i);
     }
 
     printf("\n// ---- WIN AREA ----\n");
@@ -377,13 +408,13 @@ void editor_draw_debug(LevelEditor* ed, Camera2D* camera) {
             DrawRectangleLinesEx(ed->level->bgs[i].dest, 2, RED);
         }
     }
+    int selected_enemy = is_state_enemy(ed->state) ? Level_ResolveEnemy(ed->level, ed->selectedEnemy) : -1;
     for (int i = 0; i < ed->level->enemyCount; i++) {
         int ext = 25;
-        if (is_state_enemy(ed->state) &&
-            i == ed->selected) {
-            DrawCircleLines(ed->level->enemies[i].position.x, ed->level->enemies[i].position.y, 25, RED);
-            DrawCircleLines(ed->level->enemies[i].position.x, ed->level->enemies[i].position.y, 24, RED);
-            DrawCircleLines(ed->level->enemies[i].position.x, ed->level->enemies[i].position.y, 23, RED);
+        if (i == selected_enemy) {
+            DrawCircleLines(ed->level->enemyBodies[i].position.x, ed->level->enemyBodies[i].position.y, 25, RED);
+            DrawCircleLines(ed->level->enemyBodies[i].position.x, ed->level->enemyBodies[i].position.y, 24, RED);
+            DrawCircleLines(ed->level->enemyBodies[i].position.x, ed->level->enemyBodies[i].position.y, 23, RED);
         }
     }
 
@@ -400,42 +431,46 @@ void editor_draw_debug(LevelEditor* ed, Camera2D* camera) {
 
 
 void editor_create_new_wall(LevelEditor* ed) {
-    if (ed->level->wallCount == MAX_WALLS) {
-        fprintf(stderr, "editor_create_new_wall: MAX_WALLS count reached in level->wallCount");
-        return;
-    }
-
-    Wall* w = &ed->level->walls[ed->level->wallCount++];
     Wall new_wall = {0};
     new_wall.rect.x = ed->mouse_world.x;
     new_wall.rect.y = ed->mouse_world.y;
     new_wall.rect.width = 25;
     new_wall.rect.height = 25;
-    *w = new_wall;
+    if (Level_AddWall(ed->level, new_wall) < 0) {
+        TraceLog(LOG_WARNING, "editor_create_new_wall: out of memory");
+        return;
+    }
+    editor_build_collision(ed);
 }
 
 void editor_create_new_enemy(LevelEditor* ed, EnemyType type) {
-    if (ed->level->enemyCount == MAX_ENEMIES) {
-        fprintf(stderr, "editor_create_new_enemy: MAX_ENEMIES count reached in level->enemyCount");
+    int index = Level_AddEnemy(ed->level);
+    if (index < 0) {
+        TraceLog(LOG_WARNING, "editor_create_new_enemy: out of memory");
         return;
     }
-    Entity* e = &ed->level->enemies[ed->level->enemyCount++];
-    *e = InitEnemy(ed->mouse_world, type);
-}
-
-void editor_create_new_door(LevelEditor* ed) {
-    if (ed->level->doorCount == MAX_DOORS) {
-        fprintf(stderr, "editor_create_new_door: MAX_DOORS count reached in level->doorCount");
+    InitEnemy(ed->level, index, ed->mouse_world, type);
+    if (!Game_OnEnemyAdded(index)) {
+        TraceLog(LOG_WARNING, "editor_create_new_enemy: out of memory");
+        ed->level->enemyCount--; // The last slot, nothing else refers to it yet
         return;
     }
+    if (!Level_BuildPatrolPoints(ed->level)) {
+        TraceLog(LOG_WARNING, "editor_create_new_enemy: out of memory building patrol points, walkers stand still");
+    }
+}
 
-    Door* w = &ed->level->doors[ed->level->doorCount++];
+void editor_create_new_door(LevelEditor* ed) {
     Door new_door = {0};
     new_door.rect.x = ed->mouse_world.x;
     new_door.rect.y = ed->mouse_world.y;
     new_door.rect.width = 25;
     new_door.rect.height = 25;
-    *w = new_door;
+    if (Level_AddDoor(ed->level, new_door) < 0) {
+        TraceLog(LOG_WARNING, "editor_create_new_door: out of memory");
+        return;
+    }
+    editor_build_collision(ed);
 }
 
 
@@ -452,14 +487,21 @@ void editor_delete_entity(LevelEditor* ed) {
         ed->level->wallCount--;
         ed->selected = -1;
         ed->state = ED_IDLE;
+        editor_build_collision(ed);
     }
     else if (is_state_enemy(ed->state)) {
-        if (idx >= ed->level->enemyCount) return;
+        idx = Level_ResolveEnemy(ed->level, ed->selectedEnemy);
+        if (idx < 0) return;
         size_t num_to_move = ed->level->enemyCount - idx - 1;
         if (num_to_move > 0) {
-            memmove(&ed->level->enemies[idx], &ed->level->enemies[idx+1], num_to_move * sizeof(Entity));
+            memmove(&ed->level->enemyBodies[idx], &ed->level->enemyBodies[idx+1], num_to_move * sizeof(EntityBody));
+            memmove(&ed->level->enemyAI[idx], &ed->level->enemyAI[idx+1], num_to_move * sizeof(EnemyAI));
+            memmove(&ed->level->enemyStats[idx], &ed->level->enemyStats[idx+1], num_to_move * sizeof(EnemyStats));
         }
+        // Every slot from idx on now holds another enemy (or none): old handles to them go stale
+        for (int i = idx; i < ed->level->enemyCount; i++) Level_RenewEnemyHandle(ed->level, i);
         ed->level->enemyCount--;
+        Game_OnEnemyRemoved(idx);
         ed->selected = -1;
         ed->state = ED_IDLE;
     }
@@ -472,6 +514,7 @@ void editor_delete_entity(LevelEditor* ed) {
         ed->level->doorCount--;
         ed->selected = -1;
         ed->state = ED_IDLE;
+        editor_build_collision(ed);
     }
 }
 
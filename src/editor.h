@@ -27,6 +27,7 @@ typedef struct {
 
     EditorState state;
     int selected;
+    Handle selectedEnemy; // In ED_MOVE_ENEMY, enemies move when one is deleted
 
     Vector2 mouse_world;
     Vector2 drag_offset;
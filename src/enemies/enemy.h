@@ -3,20 +3,40 @@
 
 #include "../entity.h"
 #include "../levels.h"
+#include "../visibility.h"
+#include "../nav.h"
+#include "enemy_commands.h"
+#include "enemy_scheduler.h"
+#include "../entity_grid.h"
 
-// Factory to create a new enemy based on type
-Entity InitEnemy(Vector2 position, EnemyType type);
+// Factory: sets up enemy `index` of the level (all its components) based on type.
+// Doesn't change level->enemyCount: make room first with Level_ResizeEnemies or
+// Level_AddEnemy, an index outside it is ignored.
+void InitEnemy(Level *level, int index, Vector2 position, EnemyType type);
 
 // Get default identity for a type (useful for player init or other needs)
 Identity GetIdentity(EnemyType type);
 
 // Check if enemy can see target (distance, angle, walls)
-bool CheckLineOfSight(Entity *enemy, Vector2 target, Level *level);
+// If `vision` is the enemy's current visibility polygon it is used instead of a raycast (may be NULL)
+bool CheckLineOfSight(const EntityBody *body, const EnemyAI *ai, Vector2 target, Level *level, const VisibilityPolygon *vision);
 
-// Updates a single enemy instance (AI, Shooting, etc.)
-// Returns true if the enemy fired a shot (helper for bullet spawning if needed,
-// or handles internal)
-void UpdateEnemy(Entity *enemy, Vector2 playerPos, Level *level, Bullet *bulletPool,
-                 int maxBullets, float dt);
+// Updates the enemies in [begin, end) that think this frame (AI, Shooting, etc.), each
+// for its schedule's thinkDt with its latest perception (seesPlayer, see EnemyScheduler).
+// Enemies are sorted by state and each state's enemies run together; a state change
+// takes effect on the next tick.
+// Only writes those enemies, their schedules and their nav paths (`paths`, indexed like
+// the level's enemies), so disjoint ranges can update in parallel; shots and nav requests go
+// to `commands` (see EnemyCommands_Apply).
+void UpdateEnemies(Level *level, EnemySchedule *schedules, NavPath *paths, Vector2 playerPos,
+                   EnemyCommandBuffer *commands, int begin, int end);
+
+#define ENEMY_JOB_MIN_BATCH 4 // Fewest enemies per batch when UpdateEnemies is split over worker threads
+
+// Local avoidance: walkers closer than their radii plus a small gap push apart
+// (bounded per frame and by wall collision), so groups spread out instead of
+// stacking. `grid` bins level->enemyBodies at their current positions; each walker
+// only looks at the first few neighbors it finds there.
+void SeparateEnemies(Level *level, const EntityGrid *grid, float dt);
 
 #endif // ENEMY_H
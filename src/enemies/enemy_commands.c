@@ -0,0 +1,78 @@
+#include "enemy_commands.h"
+#include "../jobs.h"
+#include <stdlib.h>
+
+#define ENEMY_BULLET_RADIUS 5.0f
+#define ENEMY_BULLET_LIFETIME 2.0f
+
+void EnemyCommands_Push(EnemyCommandBuffer *buffer, EnemyCommand command) {
+    if (buffer->count == buffer->capacity) {
+        int capacity = (buffer->capacity > 0) ? buffer->capacity * 2 : ENEMY_COMMANDS_INITIAL_CAPACITY;
+        EnemyCommand *items = (EnemyCommand *)realloc(buffer->items, sizeof(EnemyCommand) * (size_t)capacity);
+        if (!items) {
+            TraceLog(LOG_WARNING, "Failed to grow enemy command buffer to %d", capacity);
+            return;
+        }
+        buffer->items = items;
+        buffer->capacity = capacity;
+    }
+
+    command.enemy = buffer->enemy;
+    buffer->items[buffer->count++] = command;
+}
+
+static void ApplyCommand(const EnemyCommand *command, Pool *bullets) {
+    switch (command->type) {
+        case ENEMY_CMD_SHOOT: {
+            Bullet *bullet = Pool_Acquire(bullets);
+            if (bullet) {
+                bullet->position = command->position;
+                bullet->velocity = command->velocity;
+                bullet->radius = ENEMY_BULLET_RADIUS;
+                bullet->lifeTime = ENEMY_BULLET_LIFETIME;
+                bullet->isPlayerOwned = false;
+            }
+        } break;
+        case ENEMY_CMD_FIND_PATH:
+            Nav_Enqueue(command->path);
+            break;
+        case ENEMY_CMD_FOLLOW_FLOW:
+            Nav_WantFlow(command->position, command->permission);
+            break;
+    }
+}
+
+// Stable sort on the enemy index. Enemies run grouped by state, so a buffer is sorted
+// within each state and there are only a few commands per frame: insertion sort.
+static void SortByEnemy(EnemyCommandBuffer *buffer) {
+    for (int i = 1; i < buffer->count; i++) {
+        EnemyCommand command = buffer->items[i];
+        int j = i;
+        while (j > 0 && buffer->items[j - 1].enemy > command.enemy) {
+            buffer->items[j] = buffer->items[j - 1];
+            j--;
+        }
+        buffer->items[j] = command;
+    }
+}
+
+void EnemyCommands_Apply(EnemyCommandBuffer *buffers, int bufferCount, Pool *bullets) {
+    // k-way merge on the enemy index: an enemy's commands all sit in one buffer
+    int heads[JOBS_MAX_WORKERS] = {0};
+    for (int b = 0; b < bufferCount; b++) SortByEnemy(&buffers[b]);
+    for (;;) {
+        int best = -1;
+        for (int b = 0; b < bufferCount; b++) {
+            if (heads[b] >= buffers[b].count) continue;
+            if (best < 0 || buffers[b].items[heads[b]].enemy < buffers[best].items[heads[best]].enemy) best = b;
+        }
+        if (best < 0) break;
+        ApplyCommand(&buffers[best].items[heads[best]++], bullets);
+    }
+    for (int b = 0; b < bufferCount; b++) buffers[b].count = 0;
+}
+
+void EnemyCommands_Free(EnemyCommandBuffer *buffer) {
+    free(buffer->items);
+    *buffer = (EnemyCommandBuffer){0};
+}
@@ -0,0 +1,48 @@
+#ifndef ENEMY_COMMANDS_H
+#define ENEMY_COMMANDS_H
+
+#include "../entity.h"
+#include "../pool.h"
+#include "../nav.h"
+
+// Deferred effects of enemy updates on shared state. Enemies update in parallel
+// (see Jobs_Run) and may only write themselves, so anything else they do (fire,
+// ask the nav module for a path or a flow field) is recorded in the command buffer
+// of their worker thread. After the parallel phase the buffers are merged by enemy
+// index and applied on the main thread, in the same order a serial loop would have.
+
+typedef enum {
+    ENEMY_CMD_SHOOT = 0,  // Spawn an enemy bullet at `position` moving at `velocity`
+    ENEMY_CMD_FIND_PATH,  // Queue the pending search of `path` (Nav_Enqueue)
+    ENEMY_CMD_FOLLOW_FLOW // Keep the flow field toward `position` for `permission` (Nav_WantFlow)
+} EnemyCommandType;
+
+typedef struct {
+    EnemyCommandType type;
+    int enemy; // Issuing enemy
+    Vector2 position;
+    Vector2 velocity;
+    PermissionLevel permission;
+    NavPath *path;
+} EnemyCommand;
+
+#define ENEMY_COMMANDS_INITIAL_CAPACITY 64
+
+// One per worker thread, aligned so workers don't share its cache line
+typedef struct {
+    _Alignas(64) EnemyCommand *items;
+    int count;
+    int capacity;
+    int enemy; // Enemy being updated, stamped on pushed commands
+} EnemyCommandBuffer;
+
+// Records a command from buffer->enemy (dropped if out of memory)
+void EnemyCommands_Push(EnemyCommandBuffer *buffer, EnemyCommand command);
+
+// Applies the commands of all buffers in enemy order (an enemy's own commands in the
+// order it pushed them) and empties the buffers. `bullets` is a Pool of Bullet.
+void EnemyCommands_Apply(EnemyCommandBuffer *buffers, int bufferCount, Pool *bullets);
+
+void EnemyCommands_Free(EnemyCommandBuffer *buffer);
+
+#endif // ENEMY_COMMANDS_H
@@ -1,45 +1,53 @@
 #include "enemy.h"
+#include "../rng.h"
 
 // Hardcoded for now, or could be passed/defined elsewhere
 #define ENEMY_SHOOT_INTERVAL 2.0f
 
-Entity InitEnemy(Vector2 position, EnemyType type) {
-    Entity enemy = {0};
-    enemy.type = type;
-    enemy.position = position;
-    enemy.active = true;
-    enemy.isPlayer = false;
-    enemy.radius = 20.0f;
-    enemy.shootTimer = ENEMY_SHOOT_INTERVAL;
-    enemy.health = 100.0f;
-    enemy.health = 100.0f;
-    enemy.maxHealth = 100.0f;
-    enemy.IGotHitImSearchingThePlayerForHowManySeconds = 5.0f; // Default duration
+void InitEnemy(Level *level, int index, Vector2 position, EnemyType type) {
+    if (index < 0 || index >= level->enemyCount) return;
+    EntityBody *body = &level->enemyBodies[index];
+    EnemyAI *ai = &level->enemyAI[index];
+    EnemyStats *stats = &level->enemyStats[index];
+
+    *body = (EntityBody){0};
+    body->position = position;
+    body->active = true;
+    body->radius = 20.0f;
+
+    *stats = (EnemyStats){0};
+    stats->type = type;
+    stats->health = 100.0f;
+    stats->maxHealth = 100.0f;
+
+    *ai = (EnemyAI){0};
+    ai->shootTimer = ENEMY_SHOOT_INTERVAL;
+    ai->IGotHitImSearchingThePlayerForHowManySeconds = 5.0f; // Default duration
 
     switch (type) {
         case ENEMY_CIVILIAN:
         case ENEMY_STAFF:
-             enemy.aiType = AI_WALKER;
-             enemy.sightRange = 1400.0f;
-             enemy.sightAngle = 120.0f;
+             ai->aiType = AI_WALKER;
+             ai->sightRange = 1400.0f;
+             ai->sightAngle = 120.0f;
              break;
         case ENEMY_GUARD:
         case ENEMY_ADMIN:
-             enemy.aiType = AI_GUARDIAN;
-             enemy.sightRange =1600.0f;
-             enemy.sightAngle = 120.0f;
+             ai->aiType = AI_GUARDIAN;
+             ai->sightRange =1600.0f;
+             ai->sightAngle = 120.0f;
              break;
     }
     
-    enemy.state = STATE_IDLE;
-    enemy.patrolStart = position;
-    enemy.active = true;
-    
-    // Randomize initial rotation for variety
-    enemy.rotation = (float)GetRandomValue(0, 360);
-    
-    enemy.identity = GetIdentity(type);
-    return enemy;
+    ai->state = STATE_IDLE;
+    ai->patrolStart = position;
+    // Randomize initial rotation for variety, the same on every run of the level
+    Rng spawn;
+    Rng_Seed(&spawn, level->seed, RNG_STREAM_SPAWN, (uint32_t)index);
+    ai->rotation = (float)Rng_Range(&spawn, 0, 360);
+
+    ai->identity = GetIdentity(type);
+    Level_RenewEnemyHandle(level, index);
 }
 
 Identity GetIdentity(EnemyType type) {
@@ -0,0 +1,123 @@
+#include "enemy_scheduler.h"
+#include "../nav.h"
+#include "../../raylib/src/raymath.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define ENEMY_SCHEDULER_INITIAL_CAPACITY 32
+
+static const float thinkIntervals[AI_LOD_COUNT] = { 0.0f, 0.1f, 0.5f };
+static const float perceiveIntervals[AI_LOD_COUNT] = { 0.0f, 0.2f };
+
+static bool IsEngaged(const EnemyAI *enemy) {
+    return enemy->state == STATE_ATTACK || enemy->state == STATE_SEARCH || enemy->state == STATE_BEING_CHOKED;
+}
+
+static AILodTier PickTier(const EntityBody *body, const EnemyAI *enemy, const Level *level, Vector2 playerPos) {
+    if (IsEngaged(enemy)) return AI_LOD_NEAR;
+
+    // Walls and closed doors block sight as well as movement, so an enemy with no
+    // route to the player's room can't see them either. Doorways have no room, skip the check there.
+    int enemyRoom = Nav_GetRoom(body->position);
+    int playerRoom = Nav_GetRoom(playerPos);
+    if (enemyRoom >= 0 && playerRoom >= 0 && enemyRoom != playerRoom &&
+        Nav_PlanRoute(level, body->position, playerPos, enemy->identity.permissionLevel, NULL, 0) < 0) {
+        return AI_LOD_FAR;
+    }
+
+    float dist = Vector2Distance(body->position, playerPos);
+    if (dist < AI_LOD_NEAR_DISTANCE) return AI_LOD_NEAR;
+    if (dist < enemy->sightRange + AI_LOD_SIGHT_MARGIN) return AI_LOD_MID;
+    return AI_LOD_FAR;
+}
+
+static bool Reserve(EnemyScheduler *scheduler, int count) {
+    if (count <= scheduler->capacity) return true;
+    int capacity = (scheduler->capacity > 0) ? scheduler->capacity * 2 : ENEMY_SCHEDULER_INITIAL_CAPACITY;
+    if (capacity < count) capacity = count;
+    EnemySchedule *enemies = (EnemySchedule *)realloc(scheduler->enemies, sizeof(EnemySchedule) * (size_t)capacity);
+    if (!enemies) {
+        TraceLog(LOG_WARNING, "Failed to grow enemy schedules to %d", capacity);
+        return false;
+    }
+    scheduler->enemies = enemies;
+    scheduler->capacity = capacity;
+    return true;
+}
+
+bool EnemyScheduler_ResetEnemy(EnemyScheduler *scheduler, const Level *level, int index) {
+    if (!Reserve(scheduler, index + 1)) return false;
+    float phase = (float)(index % 8) / 8.0f;
+    scheduler->enemies[index] = (EnemySchedule){
+        .tier = AI_LOD_NEAR,
+        .tierTimer = AI_LOD_RETIER_INTERVAL * phase,
+        .thinkTimer = thinkIntervals[AI_LOD_FAR] * phase,
+        .perceiveTimer = 0.0f,
+    };
+    Rng_Seed(&scheduler->enemies[index].rng, level->seed, RNG_STREAM_ENEMY_AI, (uint32_t)index);
+    return true;
+}
+
+bool EnemyScheduler_Reset(EnemyScheduler *scheduler, const Level *level) {
+    scheduler->perceptionCursor = 0;
+    if (!Reserve(scheduler, level->enemyCount)) return false;
+    for (int i = 0; i < level->enemyCount; i++) EnemyScheduler_ResetEnemy(scheduler, level, i);
+    return true;
+}
+
+void EnemyScheduler_RemoveEnemy(EnemyScheduler *scheduler, const Level *level, int index) {
+    int count = level->enemyCount;
+    if (index < 0 || index > count || count >= scheduler->capacity) return;
+    memmove(&scheduler->enemies[index], &scheduler->enemies[index + 1], sizeof(EnemySchedule) * (size_t)(count - index));
+    if (scheduler->perceptionCursor > index) scheduler->perceptionCursor--;
+}
+
+void EnemyScheduler_Plan(EnemyScheduler *scheduler, const Level *level, Vector2 playerPos, float dt) {
+    int count = level->enemyCount;
+    for (int i = 0; i < count; i++) {
+        EnemySchedule *s = &scheduler->enemies[i];
+        const EnemyAI *enemy = &level->enemyAI[i];
+        s->think = false;
+        s->perceive = false;
+        if (!level->enemyBodies[i].active) continue;
+
+        // Alerted enemies (hit, choked, spotted the player) come close at once
+        s->tierTimer -= dt;
+        if (s->tierTimer <= 0.0f || (IsEngaged(enemy) && s->tier != AI_LOD_NEAR)) {
+            s->tier = PickTier(&level->enemyBodies[i], enemy, level, playerPos);
+            s->tierTimer = AI_LOD_RETIER_INTERVAL;
+        }
+        if (s->tier == AI_LOD_FAR) s->seesPlayer = false; // Never perceives again until it comes closer
+
+        s->pendingDt += dt;
+        s->thinkTimer -= dt;
+        s->perceiveTimer -= dt;
+        if (s->thinkTimer <= 0.0f) {
+            s->think = true;
+            s->thinkDt = s->pendingDt;
+            s->pendingDt = 0.0f;
+            s->thinkTimer = thinkIntervals[s->tier];
+        }
+    }
+
+    // Fixed perception budget, round-robin over the enemies that are due. Far enemies
+    // can't see the player at all, they only wake up to noise (see Noise_Propagate).
+    int budget = AI_PERCEPTION_BUDGET;
+    int last = -1;
+    for (int k = 0; k < count && budget > 0; k++) {
+        int i = (scheduler->perceptionCursor + k) % count;
+        EnemySchedule *s = &scheduler->enemies[i];
+        if (!level->enemyBodies[i].active || s->tier == AI_LOD_FAR || s->perceiveTimer > 0.0f) continue;
+        s->perceive = true;
+        s->perceiveTimer = perceiveIntervals[s->tier];
+        budget--;
+        last = i;
+    }
+    if (last >= 0) scheduler->perceptionCursor = (last + 1) % count;
+}
+
+void EnemyScheduler_Free(EnemyScheduler *scheduler) {
+    free(scheduler->enemies);
+    scheduler->enemies = NULL;
+    scheduler->capacity = 0;
+}
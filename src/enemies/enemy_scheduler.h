@@ -0,0 +1,68 @@
+#ifndef ENEMY_SCHEDULER_H
+#define ENEMY_SCHEDULER_H
+
+#include "../entity.h"
+#include "../levels.h"
+#include "../rng.h"
+#include <stdbool.h>
+
+// AI level of detail. Each enemy is put in a tier by distance to the player and
+// whether it can reach the player's room at all; farther tiers think and look less
+// often. Skipped time is accumulated and simulated when the enemy next thinks.
+// Perception (vision cone + line of sight) is also capped per frame: due enemies
+// are served round-robin, the rest keep their last result until their turn. Far
+// enemies don't look at all until a noise or a hit engages them.
+
+typedef enum {
+    AI_LOD_NEAR = 0, // Engaged or close: every frame
+    AI_LOD_MID,      // Player within sight range
+    AI_LOD_FAR,      // Out of sight range, or no route to the player's room: no perception
+    AI_LOD_COUNT
+} AILodTier;
+
+#define AI_LOD_NEAR_DISTANCE 1000.0f
+#define AI_LOD_SIGHT_MARGIN 300.0f     // MID reaches this far past an enemy's sight range
+#define AI_LOD_RETIER_INTERVAL 0.25f
+#define AI_LOD_MAX_STEP 0.1f           // Longest tick UpdateEnemies runs when catching up
+#define AI_PERCEPTION_BUDGET 12        // Perception checks per frame
+
+typedef struct {
+    AILodTier tier;
+    float tierTimer;     // Until the tier is picked again
+    float thinkTimer;    // Until the next update
+    float perceiveTimer; // Until perception is due again
+    float pendingDt;     // Time since the last update
+
+    // This frame's plan (see EnemyScheduler_Plan)
+    bool think;
+    float thinkDt;
+    bool perceive;
+
+    bool seesPlayer;  // Last perception result
+    Rng rng;          // The enemy's AI stream (RNG_STREAM_ENEMY_AI)
+} EnemySchedule;
+
+typedef struct {
+    EnemySchedule *enemies; // One per level enemy, grown by Reset/ResetEnemy
+    int capacity;
+    int perceptionCursor; // Next enemy in the round-robin
+} EnemyScheduler;
+
+// Puts every enemy in the near tier, with timers staggered so later tiers don't all fire
+// together, and seeds their random streams from the level. False if out of memory.
+bool EnemyScheduler_Reset(EnemyScheduler *scheduler, const Level *level);
+
+// Resets the schedule of enemy `index` alone (a new enemy in that slot). False if out of memory.
+bool EnemyScheduler_ResetEnemy(EnemyScheduler *scheduler, const Level *level, int index);
+
+// Enemy `index` was removed and the ones after it moved down one (level->enemyCount is
+// already the new count): their schedules, random streams included, move with them
+void EnemyScheduler_RemoveEnemy(EnemyScheduler *scheduler, const Level *level, int index);
+
+// Advances the timers by dt and decides which enemies think (with how much dt)
+// and which perceive this frame
+void EnemyScheduler_Plan(EnemyScheduler *scheduler, const Level *level, Vector2 playerPos, float dt);
+
+void EnemyScheduler_Free(EnemyScheduler *scheduler);
+
+#endif // ENEMY_SCHEDULER_H
@@ -0,0 +1,113 @@
+#include "entity_grid.h"
+#include <math.h>
+
+static int ClampInt(int v, int lo, int hi) {
+    if (v < lo) return lo;
+    if (v > hi) return hi;
+    return v;
+}
+
+static int CellOf(const EntityGrid *grid, Vector2 p) {
+    float inv = 1.0f / grid->cellSize;
+    int cx = ClampInt((int)floorf((p.x - grid->origin.x) * inv), 0, grid->cols - 1);
+    int cy = ClampInt((int)floorf((p.y - grid->origin.y) * inv), 0, grid->rows - 1);
+    return cy * grid->cols + cx;
+}
+
+void EntityGrid_Build(EntityGrid *grid, const EntityBody *bodies, int count) {
+    grid->cols = 0;
+    grid->rows = 0;
+    grid->cellSize = ENTITY_GRID_CELL_SIZE;
+    grid->maxRadius = 0.0f;
+    grid->origin = (Vector2){0};
+    if (count > ENTITY_GRID_MAX_ITEMS) count = ENTITY_GRID_MAX_ITEMS;
+
+    // Bounds of the active entity centers
+    bool any = false;
+    float minX = 0, minY = 0, maxX = 0, maxY = 0;
+    for (int i = 0; i < count; i++) {
+        if (!bodies[i].active) continue;
+        Vector2 p = bodies[i].position;
+        if (!any) {
+            minX = maxX = p.x;
+            minY = maxY = p.y;
+            any = true;
+        } else {
+            minX = fminf(minX, p.x);
+            minY = fminf(minY, p.y);
+            maxX = fmaxf(maxX, p.x);
+            maxY = fmaxf(maxY, p.y);
+        }
+        grid->maxRadius = fmaxf(grid->maxRadius, bodies[i].radius);
+    }
+    if (!any) return;
+
+    grid->origin = (Vector2){ minX, minY };
+    for (;;) {
+        grid->cols = (int)floorf((maxX - minX) / grid->cellSize) + 1;
+        grid->rows = (int)floorf((maxY - minY) / grid->cellSize) + 1;
+        if (grid->cols * grid->rows <= ENTITY_GRID_MAX_CELLS) break;
+        grid->cellSize *= 2.0f;
+    }
+
+    // Counting sort of entities by cell
+    int cellCount = grid->cols * grid->rows;
+    for (int c = 0; c <= cellCount; c++) grid->start[c] = 0;
+    for (int i = 0; i < count; i++) {
+        if (bodies[i].active) grid->start[CellOf(grid, bodies[i].position) + 1]++;
+    }
+    for (int c = 0; c < cellCount; c++) grid->start[c + 1] += grid->start[c];
+
+    // start[c] is used as the write cursor, then shifted back
+    for (int i = 0; i < count; i++) {
+        if (bodies[i].active) grid->items[grid->start[CellOf(grid, bodies[i].position)]++] = i;
+    }
+    for (int c = cellCount; c > 0; c--) grid->start[c] = grid->start[c - 1];
+    grid->start[0] = 0;
+}
+
+EntityGridIter EntityGrid_Query(const EntityGrid *grid, Rectangle area) {
+    EntityGridIter it = { .grid = grid };
+
+    // Empty range: Next() fails immediately
+    it.cy = 1;
+    it.cy1 = 0;
+    if (grid->cols <= 0 || grid->rows <= 0) return it;
+
+    float r = grid->maxRadius;
+    float inv = 1.0f / grid->cellSize;
+    int x0 = (int)floorf((area.x - r - grid->origin.x) * inv);
+    int y0 = (int)floorf((area.y - r - grid->origin.y) * inv);
+    int x1 = (int)floorf((area.x + area.width + r - grid->origin.x) * inv);
+    int y1 = (int)floorf((area.y + area.height + r - grid->origin.y) * inv);
+    if (x1 < 0 || y1 < 0 || x0 >= grid->cols || y0 >= grid->rows) return it;
+
+    it.cx0 = ClampInt(x0, 0, grid->cols - 1);
+    it.cx1 = ClampInt(x1, 0, grid->cols - 1);
+    it.cy = ClampInt(y0, 0, grid->rows - 1);
+    it.cy1 = ClampInt(y1, 0, grid->rows - 1);
+    it.cx = it.cx0;
+    int c = it.cy * grid->cols + it.cx;
+    it.item = grid->start[c];
+    it.itemEnd = grid->start[c + 1];
+    return it;
+}
+
+bool EntityGridIter_Next(EntityGridIter *it, int *index) {
+    while (it->cy <= it->cy1) {
+        if (it->item < it->itemEnd) {
+            *index = it->grid->items[it->item++];
+            return true;
+        }
+
+        // Advance to next cell in the range
+        if (++it->cx > it->cx1) {
+            it->cx = it->cx0;
+            if (++it->cy > it->cy1) break;
+        }
+        int c = it->cy * it->grid->cols + it->cx;
+        it->item = it->grid->start[c];
+        it->itemEnd = it->grid->start[c + 1];
+    }
+    return false;
+}
@@ -0,0 +1,42 @@
+#ifndef ENTITY_GRID_H
+#define ENTITY_GRID_H
+
+#include "entity.h"
+#include <stdbool.h>
+
+// Loose uniform grid over moving entities, rebuilt every frame.
+// Each active entity is stored once, in the cell holding its center; queries grow
+// the area by the largest radius seen at build time so overlapping circles are
+// still found. Used as the broadphase for bullets vs enemies.
+
+#define ENTITY_GRID_CELL_SIZE 64.0f
+#define ENTITY_GRID_MAX_CELLS 1024
+#define ENTITY_GRID_MAX_ITEMS 256
+
+typedef struct {
+    Vector2 origin;
+    float cellSize;
+    float maxRadius;
+    int cols;
+    int rows;
+
+    // Cell c owns items[start[c] .. start[c + 1])
+    int start[ENTITY_GRID_MAX_CELLS + 1];
+    int items[ENTITY_GRID_MAX_ITEMS];
+} EntityGrid;
+
+typedef struct {
+    const EntityGrid *grid;
+    int cx0, cx1, cy1;
+    int cx, cy;
+    int item, itemEnd;
+} EntityGridIter;
+
+// Indexes the active bodies of `bodies[0 .. count)` (at most ENTITY_GRID_MAX_ITEMS)
+void EntityGrid_Build(EntityGrid *grid, const EntityBody *bodies, int count);
+
+// Iterates indices of entities whose circle may overlap `area`. Each index is returned once.
+EntityGridIter EntityGrid_Query(const EntityGrid *grid, Rectangle area);
+bool EntityGridIter_Next(EntityGridIter *it, int *index);
+
+#endif // ENTITY_GRID_H
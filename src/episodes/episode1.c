@@ -18,7 +18,7 @@ static Texture2D texZone7;
 // Snake Layout: 7 Zones
   // Z1(0,0)->Z2(1.5k,0)->Z3(3k,0) -> Down -> Z4(3k,1k)->Z5(1.5k,1k)->Z6(0,1k) -> Down -> Z7(0,2k)
   
-void InitEpisode1(Level *level) {
+bool InitEpisode1(Level *level) {
   // Identities - Unique Keys per Zone
   Identity idCivilian = {.permissionLevel = PERM_NONE, .color = BLUE, .speed = 220.0f};
   
@@ -57,61 +57,61 @@ void InitEpisode1(Level *level) {
 
   // --- External Boundaries ---
 // Replace all rectangle assignments with Wall struct assignments
-// Example: level->walls[level->wallCount++] = (Wall){ (Rectangle){...}, 0.0f };
+// Example: Level_AddWall(level, (Wall){ (Rectangle){...}, 0.0f });
 // Since there are many, I will use a regex if possible or just replace the assignments.
 // Actually, I'll use a smarter regex in my head: `(Rectangle){` -> `(Wall){(Rectangle){` + `}, 0.0f}`
 // But multi_replace doesn't support regex in replacement efficiently across many lines without explicit chunks.
 // I'll try to replace groups.
 
 // Group 1: Boundaries
-  level->walls[level->wallCount++] = (Wall){(Rectangle){-50, -50, 3000, 50}, 0.0f};
+  if (Level_AddWall(level, (Wall){(Rectangle){-50, -50, 3000, 50}, 0.0f}) < 0) return false;
   
   // Left Side
-  level->walls[level->wallCount++] = (Wall){(Rectangle){-50, 0, 50, 642}, 0.0f}; 
-  level->walls[level->wallCount++] = (Wall){(Rectangle){112, 654, 50, 853}, 0.0f};
-  level->walls[level->wallCount++] = (Wall){(Rectangle){112, 1507, 50, 805}, 0.0f};
+  if (Level_AddWall(level, (Wall){(Rectangle){-50, 0, 50, 642}, 0.0f}) < 0) return false; 
+  if (Level_AddWall(level, (Wall){(Rectangle){112, 654, 50, 853}, 0.0f}) < 0) return false;
+  if (Level_AddWall(level, (Wall){(Rectangle){112, 1507, 50, 805}, 0.0f}) < 0) return false;
 
   // Right Side
-  level->walls[level->wallCount++] = (Wall){(Rectangle){2781, 0, 50, 654}, 0.0f};
-  level->walls[level->wallCount++] = (Wall){(Rectangle){2693, 654, 50, 645}, 0.0f};
+  if (Level_AddWall(level, (Wall){(Rectangle){2781, 0, 50, 654}, 0.0f}) < 0) return false;
+  if (Level_AddWall(level, (Wall){(Rectangle){2693, 654, 50, 645}, 0.0f}) < 0) return false;
 
   // Bottoms
-  level->walls[level->wallCount++] = (Wall){(Rectangle){1824, 1299, 900, 50}, 0.0f};
-  level->walls[level->wallCount++] = (Wall){(Rectangle){957, 1303, 900, 50}, 0.0f};
-  level->walls[level->wallCount++] = (Wall){(Rectangle){112, 2312, 900, 50}, 0.0f};
+  if (Level_AddWall(level, (Wall){(Rectangle){1824, 1299, 900, 50}, 0.0f}) < 0) return false;
+  if (Level_AddWall(level, (Wall){(Rectangle){957, 1303, 900, 50}, 0.0f}) < 0) return false;
+  if (Level_AddWall(level, (Wall){(Rectangle){112, 2312, 900, 50}, 0.0f}) < 0) return false;
 
   // Right Side of Z7
-  level->walls[level->wallCount++] = (Wall){(Rectangle){957, 1507, 20, 805}, 0.0f}; 
+  if (Level_AddWall(level, (Wall){(Rectangle){957, 1507, 20, 805}, 0.0f}) < 0) return false; 
 
   // --- Internal Steps/Gaps ---
-  level->walls[level->wallCount++] = (Wall){(Rectangle){0, 642, 913, 20}, 0.0f}; 
+  if (Level_AddWall(level, (Wall){(Rectangle){0, 642, 913, 20}, 0.0f}) < 0) return false; 
 
-  level->walls[level->wallCount++] = (Wall){(Rectangle){913, 661, 911, 20}, 0.0f}; 
+  if (Level_AddWall(level, (Wall){(Rectangle){913, 661, 911, 20}, 0.0f}) < 0) return false; 
 
-  level->walls[level->wallCount++] = (Wall){(Rectangle){1824, 654, 300, 20}, 0.0f}; 
-  level->walls[level->wallCount++] = (Wall){(Rectangle){2244, 654, 537, 20}, 0.0f}; 
+  if (Level_AddWall(level, (Wall){(Rectangle){1824, 654, 300, 20}, 0.0f}) < 0) return false; 
+  if (Level_AddWall(level, (Wall){(Rectangle){2244, 654, 537, 20}, 0.0f}) < 0) return false; 
 
-  level->walls[level->wallCount++] = (Wall){(Rectangle){162, 642, 795, 20}, 0.0f}; 
+  if (Level_AddWall(level, (Wall){(Rectangle){162, 642, 795, 20}, 0.0f}) < 0) return false; 
 
   // --- Vertical Dividers (Doors) ---
-  level->walls[level->wallCount++] = (Wall){(Rectangle){913, 0, 20, 260}, 0.0f};
-  level->walls[level->wallCount++] = (Wall){(Rectangle){913, 380, 20, 300}, 0.0f}; 
+  if (Level_AddWall(level, (Wall){(Rectangle){913, 0, 20, 260}, 0.0f}) < 0) return false;
+  if (Level_AddWall(level, (Wall){(Rectangle){913, 380, 20, 300}, 0.0f}) < 0) return false; 
 
-  level->walls[level->wallCount++] = (Wall){(Rectangle){1824, 0, 20, 260}, 0.0f};
-  level->walls[level->wallCount++] = (Wall){(Rectangle){1824, 380, 20, 300}, 0.0f};
+  if (Level_AddWall(level, (Wall){(Rectangle){1824, 0, 20, 260}, 0.0f}) < 0) return false;
+  if (Level_AddWall(level, (Wall){(Rectangle){1824, 380, 20, 300}, 0.0f}) < 0) return false;
 
-  level->walls[level->wallCount++] = (Wall){(Rectangle){1824, 654, 20, 260}, 0.0f};
-  level->walls[level->wallCount++] = (Wall){(Rectangle){1824, 1034, 20, 300}, 0.0f};
+  if (Level_AddWall(level, (Wall){(Rectangle){1824, 654, 20, 260}, 0.0f}) < 0) return false;
+  if (Level_AddWall(level, (Wall){(Rectangle){1824, 1034, 20, 300}, 0.0f}) < 0) return false;
 
-  level->walls[level->wallCount++] = (Wall){(Rectangle){957, 654, 20, 260}, 0.0f};
-  level->walls[level->wallCount++] = (Wall){(Rectangle){957, 1034, 20, 300}, 0.0f};
-  level->walls[level->wallCount++] = (Wall){(Rectangle){957, 1334, 20, 173}, 0.0f};
+  if (Level_AddWall(level, (Wall){(Rectangle){957, 654, 20, 260}, 0.0f}) < 0) return false;
+  if (Level_AddWall(level, (Wall){(Rectangle){957, 1034, 20, 300}, 0.0f}) < 0) return false;
+  if (Level_AddWall(level, (Wall){(Rectangle){957, 1334, 20, 173}, 0.0f}) < 0) return false;
 
-  level->walls[level->wallCount++] = (Wall){(Rectangle){162, 1507, 300, 20}, 0.0f}; 
-  level->walls[level->wallCount++] = (Wall){(Rectangle){582, 1507, 400, 20}, 0.0f}; 
+  if (Level_AddWall(level, (Wall){(Rectangle){162, 1507, 300, 20}, 0.0f}) < 0) return false; 
+  if (Level_AddWall(level, (Wall){(Rectangle){582, 1507, 400, 20}, 0.0f}) < 0) return false; 
 
   // --- Doors ---
-  level->doorCount = 6;
+  if (!Level_ResizeDoors(level, 6)) return false;
   // D1 (X=913)
   level->doors[0].rect = (Rectangle){913, 260, 20, 120};
   level->doors[0].requiredPerm = PERM_STAFF;
@@ -142,37 +142,37 @@ void InitEpisode1(Level *level) {
   }
 
   // --- Enemies (Unique Keys) ---
-  level->enemyCount = 7;
+  if (!Level_ResizeEnemies(level, 7)) return false;
   
   // Z1 (450, 320) - Key Z1 (Staff) -> Walker
-  level->enemies[0] = InitEnemy((Vector2){450, 320}, ENEMY_STAFF); // Base properties
-  level->enemies[0].identity = idKeyZ1; // Override identity if needed
-  level->enemies[0].haveMask = true;    // Has Mask
+  InitEnemy(level, 0, (Vector2){450, 320}, ENEMY_STAFF); // Base properties
+  level->enemyAI[0].identity = idKeyZ1; // Override identity if needed
+  level->enemyStats[0].haveMask = true;    // Has Mask
   
   // Z2 (1350, 320) - Key Z2 (Guard) -> Guardian
-  level->enemies[1] = InitEnemy((Vector2){1350, 320}, ENEMY_GUARD);
-  level->enemies[1].identity = idKeyZ2;
-  level->enemies[1].haveMask = false;   // No Mask
+  InitEnemy(level, 1, (Vector2){1350, 320}, ENEMY_GUARD);
+  level->enemyAI[1].identity = idKeyZ2;
+  level->enemyStats[1].haveMask = false;   // No Mask
   
   // Z3 (2250, 320) - Key Z3 (Admin) -> Guardian
-  level->enemies[2] = InitEnemy((Vector2){2250, 320}, ENEMY_ADMIN);
-  level->enemies[2].identity = idKeyZ3;
+  InitEnemy(level, 2, (Vector2){2250, 320}, ENEMY_ADMIN);
+  level->enemyAI[2].identity = idKeyZ3;
   
   // Z4 (2250, 970) - Key Z4 (Guard) -> Guardian
-  level->enemies[3] = InitEnemy((Vector2){2250, 970}, ENEMY_GUARD);
-  level->enemies[3].identity = idKeyZ4;
+  InitEnemy(level, 3, (Vector2){2250, 970}, ENEMY_GUARD);
+  level->enemyAI[3].identity = idKeyZ4;
   
   // Z5 (1350, 970) - Key Z5 (Staff) -> Walker
-  level->enemies[4] = InitEnemy((Vector2){1350, 970}, ENEMY_STAFF);
-  level->enemies[4].identity = idKeyZ5;
+  InitEnemy(level, 4, (Vector2){1350, 970}, ENEMY_STAFF);
+  level->enemyAI[4].identity = idKeyZ5;
   
   // Z6 (500, 970) - Key Z6 (Admin) -> Guardian
-  level->enemies[5] = InitEnemy((Vector2){500, 970}, ENEMY_ADMIN);
-  level->enemies[5].identity = idKeyZ6;
+  InitEnemy(level, 5, (Vector2){500, 970}, ENEMY_ADMIN);
+  level->enemyAI[5].identity = idKeyZ6;
   
   // Z7 (500, 1900) - Final Guard -> Guardian
-  level->enemies[6] = InitEnemy((Vector2){500, 1900}, ENEMY_ADMIN);
-  level->enemies[6].identity = idKeyZ3;
+  InitEnemy(level, 6, (Vector2){500, 1900}, ENEMY_ADMIN);
+  level->enemyAI[6].identity = idKeyZ3;
 
 
 
@@ -185,6 +185,7 @@ void InitEpisode1(Level *level) {
     if (texZone6.id == 0)texZone6 = LoadTexture("assets/environment/background_6.png");
     if (texZone7.id == 0)texZone7 = LoadTexture("assets/environment/background_7.png");
 
+    if (!Level_ResizeBackgrounds(level, 8)) return false;
     level->bgs[0] = (Background){texZone1, (Rectangle){0,0,texZone1.width,texZone1.height}, (Rectangle){0,0,913,642}};
     level->bgs[2] = (Background){texZone2, (Rectangle){0,0,texZone2.width,texZone2.height}, (Rectangle){913,0,911,661}};
     level->bgs[3] = (Background){texZone3, (Rectangle){0,0,texZone3.width,texZone3.height}, (Rectangle){1824,0,957,654}};
@@ -192,10 +193,10 @@ void InitEpisode1(Level *level) {
     level->bgs[5] = (Background){texZone5, (Rectangle){0,0,texZone5.width,texZone5.height}, (Rectangle){957,654,867,649}};
     level->bgs[6] = (Background){texZone6, (Rectangle){0,0,texZone6.width,texZone6.height}, (Rectangle){162,654,795,853}};
     level->bgs[7] = (Background){texZone7, (Rectangle){0,0,texZone7.width,texZone7.height}, (Rectangle){162,1507,795,805}};
-	level->bgs_count = 8;
 
     // ---- WIN AREA ----
     level->win_area = (Rectangle){341.961548,2164.302490,438.000000,274.000000};
+    return true;
 }
 
 void UnloadEpisode1() {
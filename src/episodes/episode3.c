@@ -3,7 +3,7 @@
 #include "episodes.h"
 #include <stdio.h> // For getting NULL
 
-void InitEpisode3(Level *level) {
+bool InitEpisode3(Level *level) {
     level->id = 3; // Episode 3
     level->playerSpawn = (Vector2){200.0f, 500.0f};
     level->playerStartId = GetIdentity(ENEMY_CIVILIAN); // Start undercover
@@ -11,7 +11,7 @@ void InitEpisode3(Level *level) {
 
 // ---- LEVEL EDITOR EXPORT ----
 // ---- WALLS ----
-level->wallCount = 34;
+if (!Level_ResizeWalls(level, 34)) return false;
 level->walls[0] = (Wall){(Rectangle){-261, 455, 57, 1417}, 0.00f};
 level->walls[1] = (Wall){(Rectangle){-218, 1814, 1389, 53}, 0.00f};
 level->walls[2] = (Wall){(Rectangle){1118, 426, 57, 1401}, 0.00f};
@@ -48,13 +48,13 @@ level->walls[32] = (Wall){(Rectangle){217, 1329, 117, 49}, 0.00f};
 level->walls[33] = (Wall){(Rectangle){-119, 523, 113, 49}, 0.00f};
 
 // ---- BACKGROUNDS ----
-level->bgs_count = 1;
+if (!Level_ResizeBackgrounds(level, 1)) return false;
 static Texture2D level_bg_textures[1];
 if (0 == level_bg_textures[0].id) level_bg_textures[0] = LoadTexture("assets/environment/background_3_1.png");
 level->bgs[0] = (Background){level_bg_textures[0], (Rectangle){0, 0, 8092, 8092}, (Rectangle){-250, 432, 1424, 1440}};
 
 // ---- DOORS ----
-level->doorCount = 9;
+if (!Level_ResizeDoors(level, 9)) return false;
 level->doors[0].rect = (Rectangle){70.951965,1118.683960,81.000000,37.000000};
 level->doors[0].requiredPerm = PERM_NONE;
 level->doors[1].rect = (Rectangle){330.952087,861.047058,69.000000,49.000000};
@@ -75,31 +75,32 @@ level->doors[8].rect = (Rectangle){437.205566,752.793701,53.000000,73.000000};
 level->doors[8].requiredPerm = PERM_STAFF;
 
 // ---- ENEMIES ----
-level->enemyCount = 19;
-level->enemies[0] = InitEnemy((Vector2){248.285339,953.350525}, ENEMY_ADMIN);
-level->enemies[1] = InitEnemy((Vector2){670.952087,949.350525}, ENEMY_ADMIN);
-level->enemies[2] = InitEnemy((Vector2){541.618591,605.350525}, ENEMY_GUARD);
-level->enemies[3] = InitEnemy((Vector2){1077.618652,526.683899}, ENEMY_GUARD);
-level->enemies[4] = InitEnemy((Vector2){375.007324,1192.886353}, ENEMY_STAFF);
-level->enemies[5] = InitEnemy((Vector2){-26.884703,1297.867798}, ENEMY_CIVILIAN);
-level->enemies[6] = InitEnemy((Vector2){1074.952148,1240.017212}, ENEMY_ADMIN);
-level->enemies[7] = InitEnemy((Vector2){815.826294,1478.551147}, ENEMY_STAFF);
-level->enemies[8] = InitEnemy((Vector2){387.273926,1069.938232}, ENEMY_STAFF);
-level->enemies[9] = InitEnemy((Vector2){-141.461121,1235.264282}, ENEMY_ADMIN);
-level->enemies[10] = InitEnemy((Vector2){120.149231,505.509460}, ENEMY_CIVILIAN);
-level->enemies[11] = InitEnemy((Vector2){383.875549,651.023682}, ENEMY_CIVILIAN);
-level->enemies[12] = InitEnemy((Vector2){446.250031,1299.077393}, ENEMY_STAFF);
-level->enemies[13] = InitEnemy((Vector2){602.103516,1249.442627}, ENEMY_CIVILIAN);
-level->enemies[14] = InitEnemy((Vector2){69.501358,1234.389038}, ENEMY_STAFF);
-level->enemies[15] = InitEnemy((Vector2){357.215790,1154.686523}, ENEMY_STAFF);
-level->enemies[16] = InitEnemy((Vector2){670.838989,1704.527954}, ENEMY_CIVILIAN);
-level->enemies[17] = InitEnemy((Vector2){823.986328,1077.843384}, ENEMY_GUARD);
-level->enemies[18] = InitEnemy((Vector2){-38.013672,763.843384}, ENEMY_GUARD);
+if (!Level_ResizeEnemies(level, 19)) return false;
+InitEnemy(level, 0, (Vector2){248.285339,953.350525}, ENEMY_ADMIN);
+InitEnemy(level, 1, (Vector2){670.952087,949.350525}, ENEMY_ADMIN);
+InitEnemy(level, 2, (Vector2){541.618591,605.350525}, ENEMY_GUARD);
+InitEnemy(level, 3, (Vector2){1077.618652,526.683899}, ENEMY_GUARD);
+InitEnemy(level, 4, (Vector2){375.007324,1192.886353}, ENEMY_STAFF);
+InitEnemy(level, 5, (Vector2){-26.884703,1297.867798}, ENEMY_CIVILIAN);
+InitEnemy(level, 6, (Vector2){1074.952148,1240.017212}, ENEMY_ADMIN);
+InitEnemy(level, 7, (Vector2){815.826294,1478.551147}, ENEMY_STAFF);
+InitEnemy(level, 8, (Vector2){387.273926,1069.938232}, ENEMY_STAFF);
+InitEnemy(level, 9, (Vector2){-141.461121,1235.264282}, ENEMY_ADMIN);
+InitEnemy(level, 10, (Vector2){120.149231,505.509460}, ENEMY_CIVILIAN);
+InitEnemy(level, 11, (Vector2){383.875549,651.023682}, ENEMY_CIVILIAN);
+InitEnemy(level, 12, (Vector2){446.250031,1299.077393}, ENEMY_STAFF);
+InitEnemy(level, 13, (Vector2){602.103516,1249.442627}, ENEMY_CIVILIAN);
+InitEnemy(level, 14, (Vector2){69.501358,1234.389038}, ENEMY_STAFF);
+InitEnemy(level, 15, (Vector2){357.215790,1154.686523}, ENEMY_STAFF);
+InitEnemy(level, 16, (Vector2){670.838989,1704.527954}, ENEMY_CIVILIAN);
+InitEnemy(level, 17, (Vector2){823.986328,1077.843384}, ENEMY_GUARD);
+InitEnemy(level, 18, (Vector2){-38.013672,763.843384}, ENEMY_GUARD);
 
 // ---- WIN AREA ----
 level->win_area = (Rectangle){428.000000,1104.000000,70.000000,106.000000};
 // ---- LEVEL EDITOR EXPORT END ----
 
+return true;
 }
 
 void UnloadEpisode3() {
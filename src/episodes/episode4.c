@@ -5,7 +5,7 @@
 
 static Texture2D texBackground;
 
-void InitEpisode4(Level *level) {
+bool InitEpisode4(Level *level) {
     level->id = 4;
     level->playerSpawn = (Vector2){200.0f, 320.0f};
     level->playerStartId = GetIdentity(ENEMY_CIVILIAN);
@@ -17,7 +17,7 @@ void InitEpisode4(Level *level) {
 
     // ---- LEVEL EDITOR EXPORT ----
 // ---- WALLS ----
-level->wallCount = 18;
+if (!Level_ResizeWalls(level, 18)) return false;
 level->walls[0] = (Wall){(Rectangle){13, 1, 2597, 113}, 0.00f};
 level->walls[1] = (Wall){(Rectangle){30, 112, 113, 2473}, 0.00f};
 level->walls[2] = (Wall){(Rectangle){2522, 116, 105, 2465}, 0.00f};
@@ -38,13 +38,13 @@ level->walls[16] = (Wall){(Rectangle){1767, 2338, 797, 233}, 0.00f};
 level->walls[17] = (Wall){(Rectangle){2018, 2098, 681, 153}, -45.00f};
 
 // ---- BACKGROUNDS ----
-level->bgs_count = 1;
+if (!Level_ResizeBackgrounds(level, 1)) return false;
 static Texture2D level_bg_textures[1];
 if (0 == level_bg_textures[0].id) level_bg_textures[0] = LoadTexture("assets/environment/back_full2.png");
 level->bgs[0] = (Background){level_bg_textures[0], (Rectangle){0, 0, 4096, 4096}, (Rectangle){29, -2, 2612, 2624}};
 
 // ---- DOORS ----
-level->doorCount = 9;
+if (!Level_ResizeDoors(level, 9)) return false;
 level->doors[0].rect = (Rectangle){1737.543091,376.712402,33.000000,229.000000};
 level->doors[0].requiredPerm = PERM_STAFF;  // Door 0: GREEN
 level->doors[1].rect = (Rectangle){2032.032471,880.386841,229.000000,61.000000};
@@ -71,87 +71,88 @@ Identity idStaff = {.permissionLevel = PERM_GUARD, .color = BLUE, .speed = 210.0
 Identity idGuard = {.permissionLevel = PERM_GUARD, .color = RED, .speed = 200.0f};
 Identity idAdmin = {.permissionLevel = PERM_ADMIN, .color = PURPLE, .speed = 250.0f};
 
-level->enemyCount = 18;
+if (!Level_ResizeEnemies(level, 18)) return false;
 
 // CIVILIANS (GREEN, PERM_STAFF)
-level->enemies[0] = InitEnemy((Vector2){735.745483,735.518005}, ENEMY_CIVILIAN);
-level->enemies[0].identity = idCivilian;
-level->enemies[0].haveMask = true;
+InitEnemy(level, 0, (Vector2){735.745483,735.518005}, ENEMY_CIVILIAN);
+level->enemyAI[0].identity = idCivilian;
+level->enemyStats[0].haveMask = true;
 
-level->enemies[1] = InitEnemy((Vector2){1615.132568,449.892944}, ENEMY_CIVILIAN);
-level->enemies[1].identity = idCivilian;
-level->enemies[1].haveMask = false;
+InitEnemy(level, 1, (Vector2){1615.132568,449.892944}, ENEMY_CIVILIAN);
+level->enemyAI[1].identity = idCivilian;
+level->enemyStats[1].haveMask = false;
 
 // GUARDS (RED, PERM_GUARD)
-level->enemies[2] = InitEnemy((Vector2){1333.033447,1338.088745}, ENEMY_GUARD);
-level->enemies[2].identity = idGuard;
-level->enemies[2].haveMask = true;
+InitEnemy(level, 2, (Vector2){1333.033447,1338.088745}, ENEMY_GUARD);
+level->enemyAI[2].identity = idGuard;
+level->enemyStats[2].haveMask = true;
 
-level->enemies[10] = InitEnemy((Vector2){558.434204,1351.944946}, ENEMY_GUARD);
-level->enemies[10].identity = idGuard;
-level->enemies[10].haveMask = false;
+InitEnemy(level, 10, (Vector2){558.434204,1351.944946}, ENEMY_GUARD);
+level->enemyAI[10].identity = idGuard;
+level->enemyStats[10].haveMask = false;
 
-level->enemies[11] = InitEnemy((Vector2){324.094482,1130.706665}, ENEMY_GUARD);
-level->enemies[11].identity = idGuard;
-level->enemies[11].haveMask = true;
+InitEnemy(level, 11, (Vector2){324.094482,1130.706665}, ENEMY_GUARD);
+level->enemyAI[11].identity = idGuard;
+level->enemyStats[11].haveMask = true;
 
-level->enemies[12] = InitEnemy((Vector2){343.988403,1493.902466}, ENEMY_GUARD);
-level->enemies[12].identity = idGuard;
-level->enemies[12].haveMask = false;
+InitEnemy(level, 12, (Vector2){343.988403,1493.902466}, ENEMY_GUARD);
+level->enemyAI[12].identity = idGuard;
+level->enemyStats[12].haveMask = false;
 
-level->enemies[13] = InitEnemy((Vector2){1613.163086,1340.200439}, ENEMY_GUARD);
-level->enemies[13].identity = idGuard;
-level->enemies[13].haveMask = true;
+InitEnemy(level, 13, (Vector2){1613.163086,1340.200439}, ENEMY_GUARD);
+level->enemyAI[13].identity = idGuard;
+level->enemyStats[13].haveMask = true;
 
-level->enemies[14] = InitEnemy((Vector2){1351.677246,1104.445679}, ENEMY_GUARD);
-level->enemies[14].identity = idGuard;
-level->enemies[14].haveMask = false;
+InitEnemy(level, 14, (Vector2){1351.677246,1104.445679}, ENEMY_GUARD);
+level->enemyAI[14].identity = idGuard;
+level->enemyStats[14].haveMask = false;
 
 // ADMINS (PURPLE, PERM_ADMIN)
-level->enemies[3] = InitEnemy((Vector2){259.235962,1985.612427}, ENEMY_ADMIN);
-level->enemies[3].identity = idAdmin;
-level->enemies[3].haveMask = true;
+InitEnemy(level, 3, (Vector2){259.235962,1985.612427}, ENEMY_ADMIN);
+level->enemyAI[3].identity = idAdmin;
+level->enemyStats[3].haveMask = true;
 
-level->enemies[4] = InitEnemy((Vector2){809.354004,2123.265869}, ENEMY_ADMIN);
-level->enemies[4].identity = idAdmin;
-level->enemies[4].haveMask = true;
+InitEnemy(level, 4, (Vector2){809.354004,2123.265869}, ENEMY_ADMIN);
+level->enemyAI[4].identity = idAdmin;
+level->enemyStats[4].haveMask = true;
 
-level->enemies[15] = InitEnemy((Vector2){2004.342529,363.679047}, ENEMY_ADMIN);
-level->enemies[15].identity = idAdmin;
-level->enemies[15].haveMask = false;
+InitEnemy(level, 15, (Vector2){2004.342529,363.679047}, ENEMY_ADMIN);
+level->enemyAI[15].identity = idAdmin;
+level->enemyStats[15].haveMask = false;
 
-level->enemies[16] = InitEnemy((Vector2){2286.748047,378.160187}, ENEMY_ADMIN);
-level->enemies[16].identity = idAdmin;
-level->enemies[16].haveMask = false;
+InitEnemy(level, 16, (Vector2){2286.748047,378.160187}, ENEMY_ADMIN);
+level->enemyAI[16].identity = idAdmin;
+level->enemyStats[16].haveMask = false;
 
-level->enemies[17] = InitEnemy((Vector2){2169.802490,619.787598}, ENEMY_ADMIN);
-level->enemies[17].identity = idAdmin;
-level->enemies[17].haveMask = true;
+InitEnemy(level, 17, (Vector2){2169.802490,619.787598}, ENEMY_ADMIN);
+level->enemyAI[17].identity = idAdmin;
+level->enemyStats[17].haveMask = true;
 
 // STAFF (BLUE, PERM_GUARD)
-level->enemies[5] = InitEnemy((Vector2){1212.596924,2263.489990}, ENEMY_STAFF);
-level->enemies[5].identity = idStaff;
-level->enemies[5].haveMask = false;
+InitEnemy(level, 5, (Vector2){1212.596924,2263.489990}, ENEMY_STAFF);
+level->enemyAI[5].identity = idStaff;
+level->enemyStats[5].haveMask = false;
 
-level->enemies[6] = InitEnemy((Vector2){1688.469727,2135.659668}, ENEMY_STAFF);
-level->enemies[6].identity = idStaff;
-level->enemies[6].haveMask = true;
+InitEnemy(level, 6, (Vector2){1688.469727,2135.659668}, ENEMY_STAFF);
+level->enemyAI[6].identity = idStaff;
+level->enemyStats[6].haveMask = true;
 
-level->enemies[7] = InitEnemy((Vector2){2142.373047,1854.279907}, ENEMY_STAFF);
-level->enemies[7].identity = idStaff;
-level->enemies[7].haveMask = false;
+InitEnemy(level, 7, (Vector2){2142.373047,1854.279907}, ENEMY_STAFF);
+level->enemyAI[7].identity = idStaff;
+level->enemyStats[7].haveMask = false;
 
-level->enemies[8] = InitEnemy((Vector2){2271.264648,1554.704346}, ENEMY_STAFF);
-level->enemies[8].identity = idStaff;
-level->enemies[8].haveMask = false;
+InitEnemy(level, 8, (Vector2){2271.264648,1554.704346}, ENEMY_STAFF);
+level->enemyAI[8].identity = idStaff;
+level->enemyStats[8].haveMask = false;
 
-level->enemies[9] = InitEnemy((Vector2){2322.656250,1276.331665}, ENEMY_STAFF);
-level->enemies[9].identity = idStaff;
-level->enemies[9].haveMask = true;
+InitEnemy(level, 9, (Vector2){2322.656250,1276.331665}, ENEMY_STAFF);
+level->enemyAI[9].identity = idStaff;
+level->enemyStats[9].haveMask = true;
 
 // ---- WIN AREA ----
 level->win_area = (Rectangle){287.192993,2234.508301,438.000000,274.000000};
 // ---- LEVEL EDITOR EXPORT END ----
+return true;
 }
 
 void UnloadEpisode4() {
@@ -3,21 +3,21 @@
 
 #include "../levels.h"
 
-// Episode Initializers
-void InitProlog(Level *level);
+// Episode Initializers. False if out of memory, the level is then incomplete.
+bool InitProlog(Level *level);
 void UnloadProlog();
 
 // Episode Initializers
-void InitEpisode1(Level *level);
+bool InitEpisode1(Level *level);
 void UnloadEpisode1();
 
-void InitEpisode2(Level *level);
+bool InitEpisode2(Level *level);
 void UnloadEpisode2();
 
-void InitEpisode3(Level *level);
+bool InitEpisode3(Level *level);
 void UnloadEpisode3();
 
-void InitEpisode4(Level *level);
+bool InitEpisode4(Level *level);
 void UnloadEpisode4();
 
 #endif // EPISODES_H
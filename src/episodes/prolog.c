@@ -47,7 +47,7 @@ static const char *plSigaraci[] = {
     "Why?"
 };
 
-void InitProlog(Level *level) {
+bool InitProlog(Level *level) {
     level->id = 0;
     level->playerSpawn = (Vector2){ 400, 800 };
 
@@ -98,7 +98,7 @@ void InitProlog(Level *level) {
     texSigaraci[5] = LoadTexture(TextFormat("%s/sigaraci/6.png", base));
 
 
-    level->bgs_count = 1;
+    if (!Level_ResizeBackgrounds(level, 1)) return false;
     level->bgs[0].texture = texProlog;
     level->bgs[0].source = (Rectangle){0, 0, texProlog.width, texProlog.height};
     level->bgs[0].dest = (Rectangle){0, 0, texProlog.width, texProlog.height};
@@ -108,7 +108,7 @@ void InitProlog(Level *level) {
     level->enemyCount = 0;
 
     // --- NPCs ---
-    level->npcCount = 3; // one of each type
+    if (!Level_ResizeNpcs(level, 3)) return false; // one of each type
     // positions for each distinct NPC
     Vector2 npcPos[3] = { { 600, 820 }, { 800, 800 }, { 500, 760 } };
     const char *names[3] = { "Balikci", "Kiz", "Sigaraci" };
@@ -184,6 +184,7 @@ void InitProlog(Level *level) {
     level->activeDialogueIsPlayer = false;
     level->showOutroLine = false;
     level->outroLineTimer = 0.0f;
+    return true;
 }
 
 void UnloadProlog() {
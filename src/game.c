@@ -1,5 +1,7 @@
 // Standard
 #include <math.h>
+#include <stdlib.h>
+#include <string.h>
 
 // External
 #include "../raylib/src/raylib.h"
@@ -13,9 +15,18 @@
 #include "entity.h"
 #include "levels.h"
 #include "gameplay_helpers.h"
+#include "pool.h"
+#include "pickups.h"
+#include "entity_grid.h"
+#include "visibility.h"
+#include "nav.h"
+#include "jobs.h"
+#include "noise.h"
+#include "rng.h"
 
 // Game Modules
 #include "enemies/enemy.h"
+#include "enemies/enemy_scheduler.h"
 #include "player/player.h"
 #include "player/player_actions.h"
 #include "player/player_render.h"
@@ -27,7 +38,6 @@
 #include "editor.h"
 
 // Game Constants
-#define MAX_BULLETS 100
 #define BULLET_SPEED 800.0f
 #define BULLET_RADIUS 5.0f
 #define BULLET_LIFETIME 2.0f
@@ -54,16 +64,23 @@ bool gameWon;
 static Entity player;
 static Camera2D camera;
 
-static Bullet bullets[MAX_BULLETS];
-#define MAX_MASKS 20
-static Entity droppedMasks[MAX_MASKS];
+static Pool bullets = POOL_INIT(Bullet, 0);
+static EntityGrid enemyGrid; // Rebuilt each frame for player pushes, crowd separation and bullet hits
+static VisibilityPolygon *enemyVision; // Vision cones, refreshed at the end of each update
+static Vector2 visionOutline[VISIBILITY_MAX_POINTS + 2]; // Scratch for drawing a cone
+static NavPath *enemyPaths; // Walker paths, searched by Nav_Update
+static int enemyTableCapacity; // Of enemyVision and enemyPaths
+#define ENEMY_TABLES_INITIAL_CAPACITY 32
+static EnemyScheduler enemyScheduler; // AI level of detail and perception budget
+static EnemyCommandBuffer enemyCommands[JOBS_MAX_WORKERS]; // Deferred enemy effects, per worker thread
+
+static NoiseQueue noise; // Player noises of this frame, heard by enemies at its end
+static Rng effectsRng;   // Blood spray (RNG_STREAM_EFFECTS)
+
+static PickupStore pickups; // Dropped masks, keycards and guns
+#define MAX_NEARBY_PICKUPS 32 // Pickups handled per frame under the player
 static float levelStartTimer = 0.0f;
 static const float LEVEL_START_DELAY = 1.0f;
-#define MAX_CARDS 10
-static Entity droppedCards[MAX_CARDS];
-
-#define MAX_DROPPED_GUNS 20
-static DroppedGun droppedGuns[MAX_DROPPED_GUNS];
 
 // Sounds
 static Sound fxShoot = {0};
@@ -76,11 +93,10 @@ typedef struct {
     Vector2 velocity;
     float life; // 0.0 to 1.0
     Color color;
-    bool active;
     float size;
 } Particle;
 
-static Particle particles[MAX_PARTICLES];
+static Pool particles = POOL_INIT(Particle, MAX_PARTICLES);
 
 static GameContext gameCtx;
 
@@ -98,7 +114,7 @@ static const float weaponShootHold = 0.2f;
 static PlayerEquipState lastEquipmentState = PLAYER_EQUIP_KNIFE;
 
 
-static int meleeTargetIndex = -1;
+static Handle meleeTarget; // Enemy in choke range, for the prompt
 static float meleeRange = 80.0f;
 static float meleePromptOffset = 40.0f;
 static float meleePromptHorizontalOffset = 40.0f;
@@ -164,6 +180,84 @@ static bool visitedZones[7];
 
 void EndLevel(int id);
 
+// Brings the vision cones of near enemies, and of those that moved this frame, up to date
+// with their pose and the door states. Cones are cached, so enemies standing still
+// (guardians) rarely rebuild theirs; far enemies refresh theirs when they perceive.
+static void UpdateEnemyVision(void) {
+    for (int i = 0; i < currentLevel.enemyCount; i++) {
+        const EnemyAI *e = &currentLevel.enemyAI[i];
+        if (!currentLevel.enemyBodies[i].active) {
+            enemyVision[i].pointCount = 0;
+            enemyVision[i].valid = false;
+            continue;
+        }
+        const EnemySchedule *s = &enemyScheduler.enemies[i];
+        if (s->tier != AI_LOD_NEAR && !s->think) continue;
+        Visibility_Update(&enemyVision[i], &currentLevel, currentLevel.enemyBodies[i].position, e->rotation, e->sightAngle, e->sightRange);
+    }
+}
+
+// Perception of enemy i: its cone against the player
+static bool PerceivePlayer(int i) {
+    const EntityBody *body = &currentLevel.enemyBodies[i];
+    const EnemyAI *e = &currentLevel.enemyAI[i];
+    Visibility_Update(&enemyVision[i], &currentLevel, body->position, e->rotation, e->sightAngle, e->sightRange);
+    return CheckLineOfSight(body, e, player.position, &currentLevel, &enemyVision[i]);
+}
+
+// Job: updates the enemies in [begin, end) that think this frame, on a worker thread.
+// Anything shared they do is deferred to the worker's command buffer.
+static void ThinkEnemies(void *ctx, int begin, int end, int worker) {
+    (void)ctx;
+    UpdateEnemies(&currentLevel, enemyScheduler.enemies, enemyPaths, player.position,
+                  &enemyCommands[worker], begin, end);
+}
+
+// Grows enemyVision and enemyPaths to `count` enemies. Queued searches point at the old
+// paths, so they are dropped and every path starts over (agents simply ask again).
+static bool ReserveEnemyTables(int count) {
+    if (count <= enemyTableCapacity) return true;
+    int capacity = (enemyTableCapacity > 0) ? enemyTableCapacity * 2 : ENEMY_TABLES_INITIAL_CAPACITY;
+    if (capacity < count) capacity = count;
+
+    VisibilityPolygon *vision = (VisibilityPolygon *)realloc(enemyVision, sizeof(VisibilityPolygon) * (size_t)capacity);
+    if (vision) {
+        memset(&vision[enemyTableCapacity], 0, sizeof(VisibilityPolygon) * (size_t)(capacity - enemyTableCapacity));
+        enemyVision = vision;
+    }
+    NavPath *paths = vision ? (NavPath *)realloc(enemyPaths, sizeof(NavPath) * (size_t)capacity) : NULL;
+    if (!paths) {
+        TraceLog(LOG_WARNING, "Failed to grow the enemy tables to %d", capacity);
+        return false;
+    }
+    Nav_CancelSearches();
+    memset(paths, 0, sizeof(NavPath) * (size_t)capacity);
+    enemyPaths = paths;
+    enemyTableCapacity = capacity;
+    return true;
+}
+
+bool Game_OnEnemyAdded(int index) {
+    if (index < 0 || index >= currentLevel.enemyCount) return false;
+    if (!ReserveEnemyTables(currentLevel.enemyCount)) return false;
+    if (!EnemyScheduler_ResetEnemy(&enemyScheduler, &currentLevel, index)) return false;
+    Nav_ResetPath(&enemyPaths[index]);
+    enemyVision[index].pointCount = 0;
+    enemyVision[index].valid = false;
+    return true;
+}
+
+void Game_OnEnemyRemoved(int index) {
+    int count = currentLevel.enemyCount; // Without the removed enemy
+    if (index < 0 || index > count) return;
+    EnemyScheduler_RemoveEnemy(&enemyScheduler, &currentLevel, index);
+    memmove(&enemyVision[index], &enemyVision[index + 1], sizeof(VisibilityPolygon) * (size_t)(count - index));
+    enemyVision[count].pointCount = 0;
+    enemyVision[count].valid = false;
+    // Queued searches point at the path slots, so paths stay put and the moved enemies search again
+    for (int i = index; i <= count; i++) Nav_ResetPath(&enemyPaths[i]);
+}
+
 void StartLevel(int id) {
 	if (id) {
 		EndLevel(id);
@@ -173,21 +267,30 @@ void StartLevel(int id) {
     gameWon = false;
     gameCtx.hasWonLastEpisode = false;
     
-    // Reset masks
-    for(int i=0; i<MAX_MASKS; i++) droppedMasks[i].active = false;
-    // Reset cards
-    for(int i=0; i<MAX_CARDS; i++) droppedCards[i].active = false;
-    // Reset guns
-    for(int i=0; i<MAX_DROPPED_GUNS; i++) droppedGuns[i].active = false;
+    // Reset drops
+    Pickups_Clear(&pickups);
+    Pool_Clear(&particles);
     
     currentState = STATE_PLAYING;
     levelStartTimer = LEVEL_START_DELAY;
 
     // Reset bullets
-    for (int i = 0; i < MAX_BULLETS; i++) bullets[i].active = false;
+    Pool_Clear(&bullets);
+    noise.count = 0;
 
     // Init Level
-    InitLevel(id, &currentLevel);
+    if (!InitLevel(id, &currentLevel) || !ReserveEnemyTables(currentLevel.enemyCount) ||
+        !EnemyScheduler_Reset(&enemyScheduler, &currentLevel)) {
+        TraceLog(LOG_ERROR, "Could not start level %d", id);
+        currentState = STATE_MENU;
+        return;
+    }
+    for (int i = 0; i < currentLevel.enemyCount; i++) {
+        enemyPaths[i] = (NavPath){0};
+        enemyVision[i] = (VisibilityPolygon){0};
+    }
+    Rng_Seed(&effectsRng, currentLevel.seed, RNG_STREAM_EFFECTS, 0);
+    UpdateEnemyVision();
 
     // Progress context
     gameCtx.hasProgress = true;
@@ -264,6 +367,8 @@ void Game_Init(void) {
     btnEpisode4 = (Rectangle){ (float)sw/2.0f - (float)btnWidth/2.0f, (float)startY + 280, (float)btnWidth, (float)btnHeight };
     btnQuit     = (Rectangle){ (float)sw/2.0f - (float)btnWidth/2.0f, (float)startY + 350, (float)btnWidth, (float)btnHeight };
 #endif
+
+    Jobs_Init();
 }
 
 // Helper for HighDPI Mouse Scaling
@@ -374,28 +479,19 @@ static PlayerEquipState MapGunToEquip(GunType type) {
 
 static void SpawnBlood(Vector2 pos, int count) {
     for (int i = 0; i < count; i++) {
-        // Find empty slot
-        int slot = -1;
-        for (int p=0; p<MAX_PARTICLES; p++) {
-            if (!particles[p].active) {
-                slot = p;
-                break;
-            }
-        }
-        
-        if (slot != -1) {
-            particles[slot].active = true;
-            particles[slot].position = pos;
-            
-            // Random direction blood spray
-            float angle = (float)GetRandomValue(0, 360) * DEG2RAD;
-            float speed = (float)GetRandomValue(100, 300);
-            
-            particles[slot].velocity = (Vector2){ cosf(angle)*speed, sinf(angle)*speed };
-            particles[slot].life = 1.0f; // 1 second
-            particles[slot].size = (float)GetRandomValue(2, 5);
-            particles[slot].color = (Color){ 200, 0, 0, 255 }; // Deep Red
-        }
+        Particle *particle = Pool_Acquire(&particles);
+        if (!particle) break; // All in use
+
+        particle->position = pos;
+
+        // Random direction blood spray
+        float angle = (float)Rng_Range(&effectsRng, 0, 360) * DEG2RAD;
+        float speed = (float)Rng_Range(&effectsRng, 100, 300);
+
+        particle->velocity = (Vector2){ cosf(angle)*speed, sinf(angle)*speed };
+        particle->life = 1.0f; // 1 second
+        particle->size = (float)Rng_Range(&effectsRng, 2, 5);
+        particle->color = (Color){ 200, 0, 0, 255 }; // Deep Red
     }
 }
 
@@ -427,16 +523,17 @@ static void UpdateGame(float dt) {
     }
     
     // Update Particles
-    for(int i=0; i<MAX_PARTICLES; i++) {
-        if(particles[i].active) {
-            particles[i].position.x += particles[i].velocity.x * dt;
-            particles[i].position.y += particles[i].velocity.y * dt;
-            particles[i].life -= dt * 2.0f; // Fade out speed
-            
-            if(particles[i].life <= 0) {
-                particles[i].active = false;
-            }
+    for (int i = 0; i < particles.count; ) {
+        Particle *particle = Pool_At(&particles, i);
+        particle->position.x += particle->velocity.x * dt;
+        particle->position.y += particle->velocity.y * dt;
+        particle->life -= dt * 2.0f; // Fade out speed
+
+        if (particle->life <= 0) {
+            Pool_Release(&particles, i); // Last particle moves into slot i, don't advance
+            continue;
         }
+        i++;
     }
 
     // Game Over / Win Logic Inputs
@@ -538,7 +635,8 @@ static void UpdateGame(float dt) {
     bool hasGunEquipped = (currentGun->type != GUN_NONE);// && currentGun->type != GUN_KNIFE);
 
     // Player Update
-    UpdatePlayer(&player, &currentLevel, dt, developerMode);
+    EntityGrid_Build(&enemyGrid, currentLevel.enemyBodies, currentLevel.enemyCount);
+    UpdatePlayer(&player, &currentLevel, &enemyGrid, dt, developerMode);
 
     // Map new inventory state to legacy renderer state
     PlayerEquipState currentEquipState = MapGunToEquip(currentGun->type);
@@ -610,9 +708,19 @@ static void UpdateGame(float dt) {
 
     // 1. Update Enemies
     if (editor.state == ED_CLOSED) {
+        EnemyScheduler_Plan(&enemyScheduler, &currentLevel, player.position, dt);
         for (int i = 0; i < currentLevel.enemyCount; i++) {
-            UpdateEnemy(&currentLevel.enemies[i], player.position, &currentLevel, bullets, MAX_BULLETS, dt);
+            EnemySchedule *s = &enemyScheduler.enemies[i];
+            if (s->perceive) s->seesPlayer = PerceivePlayer(i); // Cone scratch is main-thread only
         }
+        Jobs_Run(ThinkEnemies, NULL, currentLevel.enemyCount, Jobs_SplitBatch(currentLevel.enemyCount, ENEMY_JOB_MIN_BATCH));
+        EnemyCommands_Apply(enemyCommands, Jobs_WorkerCount(), &bullets); // Same order as a serial loop
+
+        // Walkers spread out instead of stacking, then the grid is left current for bullets
+        EntityGrid_Build(&enemyGrid, currentLevel.enemyBodies, currentLevel.enemyCount);
+        SeparateEnemies(&currentLevel, &enemyGrid, dt);
+        EntityGrid_Build(&enemyGrid, currentLevel.enemyBodies, currentLevel.enemyCount);
+        Nav_Update(&currentLevel); // Path searches requested above, within the frame budget
     }
 
     // 2. Player Shooting
@@ -623,21 +731,19 @@ static void UpdateGame(float dt) {
         if (canShoot) {
             if (currentGun->currentAmmo > 0) {
                 // Spawn Bullet
-                for (int i = 0; i < MAX_BULLETS; i++) {
-                    if (!bullets[i].active) {
-                        bullets[i].active = true;
-                        bullets[i].position = player.position;
-                        bullets[i].radius = BULLET_RADIUS;
-                        bullets[i].lifeTime = BULLET_LIFETIME;
-                        bullets[i].isPlayerOwned = true;
-                        bullets[i].velocity = Vector2Scale(aimDirNormalized, BULLET_SPEED);
-                        bullets[i].damage = currentGun->damage; // Use gun damage stats
-                        
-                        currentGun->currentAmmo--;
-                        weaponShootTimer = currentGun->cooldown;
-                        PlaySound(fxShoot); // Ensure sound plays if loaded
-                        break;
-                    }
+                Bullet *bullet = Pool_Acquire(&bullets);
+                if (bullet) {
+                    bullet->position = player.position;
+                    bullet->radius = BULLET_RADIUS;
+                    bullet->lifeTime = BULLET_LIFETIME;
+                    bullet->isPlayerOwned = true;
+                    bullet->velocity = Vector2Scale(aimDirNormalized, BULLET_SPEED);
+                    bullet->damage = currentGun->damage; // Use gun damage stats
+                    
+                    currentGun->currentAmmo--;
+                    weaponShootTimer = currentGun->cooldown;
+                    PlaySound(fxShoot); // Ensure sound plays if loaded
+                    Noise_Emit(&noise, player.position, NOISE_GUNSHOT_LOUDNESS);
                 }
                 
                 // Auto-reload check
@@ -659,12 +765,12 @@ static void UpdateGame(float dt) {
     }
 
     // 3. Melee Logic (Knife / Choke / Stealth Kill)
-    meleeTargetIndex = -1;
+    meleeTarget = HANDLE_NONE;
     
     // Check for Choke Target (Always check range for UI prompt)
     int chokeTarget = PlayerActions_GetClosestEnemyInRange(&currentLevel, player.position, 80.0f); // Increased range from 40->80
     if (chokeTarget != -1) {
-        meleeTargetIndex = chokeTarget; // Set for UI prompt usage
+        meleeTarget = Level_EnemyHandle(&currentLevel, chokeTarget); // Set for UI prompt usage
     }
 
     // Choke Logic (Hold E)
@@ -674,21 +780,22 @@ static void UpdateGame(float dt) {
              // 1. Find target
              int potentialTarget = PlayerActions_GetClosestEnemyInRange(&currentLevel, player.position, 80.0f);
              if (potentialTarget != -1) {
-                 Entity *tgt = &currentLevel.enemies[potentialTarget];
+                 EntityBody *tgtBody = &currentLevel.enemyBodies[potentialTarget];
+                 EnemyAI *tgt = &currentLevel.enemyAI[potentialTarget];
                  // 2. Check visibility (Stealth)
-                 bool seen = CheckLineOfSight(tgt, player.position, &currentLevel);
-                 if (!seen && tgt->active) {
+                 bool seen = CheckLineOfSight(tgtBody, tgt, player.position, &currentLevel, &enemyVision[potentialTarget]);
+                 if (!seen && tgtBody->active) {
                      // 3. Start Choke
                      player.isChoking = true;
-                     player.chokeTargetIndex = potentialTarget;
+                     player.chokeTarget = Level_EnemyHandle(&currentLevel, potentialTarget);
                      player.chokeTimer = 0.0f;
                      tgt->state = STATE_BEING_CHOKED;
                  }
              }
          } else {
              // CONTINUE CHOKING
-             Entity *tgt = &currentLevel.enemies[player.chokeTargetIndex];
-             if (tgt->active && tgt->state == STATE_BEING_CHOKED) {
+             int target = Level_ResolveEnemy(&currentLevel, player.chokeTarget);
+             if (target >= 0 && currentLevel.enemyBodies[target].active && currentLevel.enemyAI[target].state == STATE_BEING_CHOKED) {
                  player.chokeTimer += dt;
                  
                  // Lock positions (optional, or just disable movement inputs)
@@ -696,7 +803,8 @@ static void UpdateGame(float dt) {
                  
                  if (player.chokeTimer >= 1.0f) {
                      // KILL
-                     PlayerActions_ApplyDamage(&currentLevel, player.chokeTargetIndex, 1000.0f, &player, droppedMasks, MAX_MASKS, droppedMaskRadius, droppedCards, MAX_CARDS, droppedGuns, MAX_DROPPED_GUNS);
+                     Noise_Emit(&noise, currentLevel.enemyBodies[target].position, NOISE_CHOKE_LOUDNESS);
+                     PlayerActions_ApplyDamage(&currentLevel, target, 1000.0f, &player, &pickups, droppedMaskRadius);
                      player.isChoking = false;
                      // tgt state handled by ApplyDamage (likely inactive)
                  }
@@ -709,9 +817,9 @@ static void UpdateGame(float dt) {
         // RELEASED E
         if (player.isChoking) {
             // Cancel Choke
-             Entity *tgt = &currentLevel.enemies[player.chokeTargetIndex];
-             if (tgt->active && tgt->state == STATE_BEING_CHOKED) {
-                 tgt->state = STATE_ATTACK; // Alerted!
+             int target = Level_ResolveEnemy(&currentLevel, player.chokeTarget);
+             if (target >= 0 && currentLevel.enemyBodies[target].active && currentLevel.enemyAI[target].state == STATE_BEING_CHOKED) {
+                 currentLevel.enemyAI[target].state = STATE_ATTACK; // Alerted!
              }
              player.isChoking = false;
              player.chokeTimer = 0.0f;
@@ -724,8 +832,9 @@ static void UpdateGame(float dt) {
          int knifeTarget = PlayerActions_GetClosestEnemyInRange(&currentLevel, player.position, currentGun->range);
          if (knifeTarget != -1) {
              // Knife Damage = 50
-             PlayerActions_ApplyDamage(&currentLevel, knifeTarget, currentGun->damage, &player, droppedMasks, MAX_MASKS, droppedMaskRadius, droppedCards, MAX_CARDS, droppedGuns, MAX_DROPPED_GUNS);
+             PlayerActions_ApplyDamage(&currentLevel, knifeTarget, currentGun->damage, &player, &pickups, droppedMaskRadius);
              PlaySound(fxShoot); // Just using shoot sound for now
+             Noise_Emit(&noise, player.position, NOISE_MELEE_LOUDNESS);
          }
          weaponShootTimer = currentGun->cooldown;
     }
@@ -735,123 +844,177 @@ static void UpdateGame(float dt) {
     // So removing E key logic block.
 
     // 4. Update Bullets
-    for (int i = 0; i < MAX_BULLETS; i++) {
-        if (!bullets[i].active) continue;
-
-        // Move
-        bullets[i].position = Vector2Add(bullets[i].position, Vector2Scale(bullets[i].velocity, dt));
-        bullets[i].lifeTime -= dt;
-
-        bool hit = false;
-        // Wall Collision
-        for (int w = 0; w < currentLevel.wallCount; w++) {
-            if (CheckCollisionCircleRotatedRect(bullets[i].position, bullets[i].radius, currentLevel.walls[w].rect, currentLevel.walls[w].rotation)) {
-                hit = true; break;
+    // Enemies are binned (enemyGrid, after they moved) so each bullet only tests the ones near its path
+
+    for (int i = 0; i < bullets.count; ) {
+        Bullet *b = Pool_At(&bullets, i);
+
+        // Sweep this frame's whole move so fast bullets can't tunnel through thin walls or enemies.
+        // Times of impact are fractions of the move; the earliest hit wins.
+        Vector2 start = b->position;
+        Vector2 end = Vector2Add(start, Vector2Scale(b->velocity, dt));
+        b->lifeTime -= dt;
+
+        // Wall / Door Collision (Closed)
+        float toi = 1.0f;
+        bool hitWall = Gameplay_SweepCircleWalls(&currentLevel, start, end, b->radius, &toi);
+        if (Gameplay_SweepCircleClosedDoors(&currentLevel, start, end, b->radius, &toi)) hitWall = true;
+
+        // Entity Collision, only counts if reached before the wall
+        int hitEnemy = -1;
+        bool hitPlayer = false;
+        if (b->isPlayerOwned) {
+            Rectangle path = {
+                fminf(start.x, end.x) - b->radius, fminf(start.y, end.y) - b->radius,
+                fabsf(end.x - start.x) + b->radius * 2.0f, fabsf(end.y - start.y) + b->radius * 2.0f
+            };
+            EntityGridIter enemyIt = EntityGrid_Query(&enemyGrid, path);
+            int e;
+            while (EntityGridIter_Next(&enemyIt, &e)) {
+                const EntityBody *body = &currentLevel.enemyBodies[e];
+                if (!body->active) continue; // Killed earlier this frame
+                if (Gameplay_SweepCircleCircle(start, end, b->radius, body->position, body->radius, &toi)) {
+                    hitEnemy = e;
+                }
             }
+        } else if (!developerMode) { // God mode check
+            hitPlayer = Gameplay_SweepCircleCircle(start, end, b->radius, player.position, player.radius, &toi);
         }
-        // Door Collision (Closed)
-        if (!hit) {
-            for (int d = 0; d < currentLevel.doorCount; d++) {
-                if (!currentLevel.doors[d].isOpen &&
-                    CheckCollisionCircleRec(bullets[i].position, bullets[i].radius, currentLevel.doors[d].rect)) {
-                    hit = true; break;
-                }
+
+        b->position = Vector2Lerp(start, end, toi);
+
+        if (hitEnemy >= 0) {
+            // Kill Enemy -> DAMAGE
+            PlayerActions_ApplyDamage(&currentLevel, 
+                                    hitEnemy, 
+                                    b->damage, // Use Bullet Damage
+                                    &player, 
+                                    &pickups, 
+                                    droppedMaskRadius);
+        } else if (hitPlayer) {
+            // Game Over Logic
+            player.health -= 1.0f;
+            SpawnBlood(player.position, 20); // SPLATTER!
+
+            if (player.health <= 0.0f) {
+                gameOver = true; 
             }
         }
 
-        if (hit || bullets[i].lifeTime <= 0) {
-            bullets[i].active = false;
+        if (hitEnemy >= 0 || hitPlayer || hitWall || b->lifeTime <= 0) {
+            Pool_Release(&bullets, i); // Last bullet moves into slot i, don't advance
             continue;
         }
+        i++;
+    }
 
-        // Entity Collision
-        if (bullets[i].isPlayerOwned) {
-            // Hit Enemy?
-            for (int e = 0; e < currentLevel.enemyCount; e++) {
-                if (currentLevel.enemies[e].active) {
-                    if (CheckCollisionCircles(bullets[i].position, bullets[i].radius, currentLevel.enemies[e].position, currentLevel.enemies[e].radius)) {
-                        // Kill Enemy -> DAMAGE
-                        PlayerActions_ApplyDamage(&currentLevel, 
-                                                e, 
-                                                bullets[i].damage, // Use Bullet Damage
-                                                &player, 
-                                                droppedMasks, 
-                                                MAX_MASKS, 
-                                                droppedMaskRadius, 
-                                                droppedCards, 
-                                                MAX_CARDS, 
-                                                droppedGuns, 
-                                                MAX_DROPPED_GUNS);
-                        
-                        bullets[i].active = false;
+    // 5. Pickups under the player
+    int nearby[MAX_NEARBY_PICKUPS];
+    int nearbyCount = Pickups_Overlapping(&pickups, player.position, player.radius, nearby, MAX_NEARBY_PICKUPS);
+    for (int n = 0; n < nearbyCount; n++) { // Highest index first: removing one leaves the others in place
+        int i = nearby[n];
+        Pickup *pickup = &pickups.items[i];
+        switch (pickup->type) {
+            case PICKUP_MASK: {
+                if (!IsKeyPressed(KEY_SPACE)) break;
+                // Pickup logic: Find empty slot
+                int emptyIdx = -1;
+                for (int s = 0; s < MAX_MASK_SLOTS; s++) {
+                    if (player.inventory.maskSlots[s].type == MASK_NONE) {
+                        emptyIdx = s;
                         break;
                     }
                 }
-            }
-        } else {
-            // Hit Player?
-            if (CheckCollisionCircles(bullets[i].position, bullets[i].radius, player.position, player.radius)) {
-                // Game Over Logic
-                if (!developerMode) { // God mode check
-                    player.health -= 1.0f;
-                    SpawnBlood(player.position, 20); // SPLATTER!
-                    
-                    if (player.health <= 0.0f) {
-                        gameOver = true; 
-                    }
-                    bullets[i].active = false;
+
+                if (emptyIdx != -1) {
+                     // Map dropped identity to mask type based on color
+                     MaskAbilityType mType = MASK_SPEED; // Default
+                     Color maskColor = pickup->maskColor;
+
+                     // RED or BLUE = STEALTH, GREEN or PURPLE = SPEED
+                     if (maskColor.r > 200 && maskColor.g < 100) {
+                         mType = MASK_STEALTH; // RED
+                     } else if (maskColor.b > 200 && maskColor.r < 100) {
+                         mType = MASK_STEALTH; // BLUE
+                     } else if (maskColor.g > 200) {
+                         mType = MASK_SPEED;   // GREEN
+                     } else if (maskColor.r > 150 && maskColor.b > 200) {
+                         mType = MASK_SPEED;   // PURPLE
+                     }
+
+                     player.inventory.maskSlots[emptyIdx].type = mType;
+                     player.inventory.maskSlots[emptyIdx].maxDuration = (mType == MASK_SPEED) ? 10.0f : 5.0f;
+                     player.inventory.maskSlots[emptyIdx].currentTimer = player.inventory.maskSlots[emptyIdx].maxDuration;
+                     player.inventory.maskSlots[emptyIdx].isActive = false;
+                     player.inventory.maskSlots[emptyIdx].collected = true;
+                     player.inventory.maskSlots[emptyIdx].color = maskColor;
+
+                     Pickups_Remove(&pickups, i);
+                     DrawText("MASK EQUIPPED!", (int)player.position.x - 20, (int)player.position.y - 60, 10, GREEN);
+                } else {
+                     DrawText("INVENTORY FULL! DROP MASK (G + Num)", (int)player.position.x - 50, (int)player.position.y - 60, 10, RED);
                 }
-            }
-        }
-    }
+            } break;
 
-    // 5. Mask Pickup
-    for (int i = 0; i < MAX_MASKS; i++) {
-        if (droppedMasks[i].active) {
-            if (CheckCollisionCircles(player.position, player.radius, droppedMasks[i].position, droppedMasks[i].radius)) {
-                if (IsKeyPressed(KEY_SPACE)) {
-                    // Pickup logic: Find empty slot
-                    int emptyIdx = -1;
-                    for (int s = 0; s < MAX_MASK_SLOTS; s++) {
-                        if (player.inventory.maskSlots[s].type == MASK_NONE) {
-                            emptyIdx = s;
-                            break;
-                        }
+            case PICKUP_CARD: {
+                // Determine if this card is better than what we have
+                if (pickup->card.level > player.inventory.card.level) {
+                     DrawText("PRESS SPACE TO PICKUP KEYCARD", (int)player.position.x - 50, (int)player.position.y - 40, 10, WHITE);
+                     if (IsKeyPressed(KEY_SPACE)) {
+                         player.inventory.card.level = pickup->card.level;
+                         Pickups_Remove(&pickups, i);
+                         // Play pickup sound?
+                     }
+                } else {
+                    // Already have better or equal, maybe just auto-collect or ignore?
+                    // Let's ignore for now but maybe show "ALREADY HAVE ACCESS"
+                }
+            } break;
+
+            case PICKUP_GUN: {
+                DrawText("PRESS SPACE TO PICKUP GUN", (int)player.position.x - 50, (int)player.position.y - 40, 10, PINK);
+                if (!IsKeyPressed(KEY_SPACE)) break;
+                // Try to find empty slot or a Knife slot to replace (SKIPPING SLOT 0)
+                int emptySlot = -1;
+                for (int s=1; s<MAX_GUN_SLOTS; s++) { // Start from 1
+                    if (player.inventory.gunSlots[s].type == GUN_NONE || player.inventory.gunSlots[s].type == GUN_KNIFE) {
+                        emptySlot = s;
+                        break;
                     }
+                }
 
-                    if (emptyIdx != -1) {
-                         // Map dropped identity to mask type based on color
-                         MaskAbilityType mType = MASK_SPEED; // Default
-                         Color maskColor = droppedMasks[i].identity.color;
-                         
-                         // RED or BLUE = STEALTH, GREEN or PURPLE = SPEED
-                         if (maskColor.r > 200 && maskColor.g < 100) {
-                             mType = MASK_STEALTH; // RED
-                         } else if (maskColor.b > 200 && maskColor.r < 100) {
-                             mType = MASK_STEALTH; // BLUE
-                         } else if (maskColor.g > 200) {
-                             mType = MASK_SPEED;   // GREEN
-                         } else if (maskColor.r > 150 && maskColor.b > 200) {
-                             mType = MASK_SPEED;   // PURPLE
+                if (emptySlot != -1) {
+                    // Take it (Overwriting Knife/None in slot 1 or 2)
+                    player.inventory.gunSlots[emptySlot] = pickup->gun;
+                    player.inventory.currentGunIndex = emptySlot; // Auto-switch?
+                    Pickups_Remove(&pickups, i);
+                    PlaySound(fxReload); // Sound cue
+                } else {
+                    // Swap with current if current is NOT Slot 0 and NOT a Knife
+                    if (player.inventory.currentGunIndex > 0) {
+                         Gun temp = player.inventory.gunSlots[player.inventory.currentGunIndex];
+
+                         if (temp.type != GUN_NONE && temp.type != GUN_KNIFE) {
+                            player.inventory.gunSlots[player.inventory.currentGunIndex] = pickup->gun;
+
+                            pickup->gun = temp; // Swap data
+                            Pickups_Move(&pickups, i, player.position); // Move drop to feet
+                         } else {
+                             // Fallback (Shouldn't happen if emptySlot logic works)
+                             player.inventory.gunSlots[player.inventory.currentGunIndex] = pickup->gun;
+                             Pickups_Remove(&pickups, i);
                          }
-                         
-                         player.inventory.maskSlots[emptyIdx].type = mType;
-                         player.inventory.maskSlots[emptyIdx].maxDuration = (mType == MASK_SPEED) ? 10.0f : 5.0f; 
-                         player.inventory.maskSlots[emptyIdx].currentTimer = player.inventory.maskSlots[emptyIdx].maxDuration;
-                         player.inventory.maskSlots[emptyIdx].isActive = false; 
-                         player.inventory.maskSlots[emptyIdx].collected = true;
-                         player.inventory.maskSlots[emptyIdx].color = droppedMasks[i].identity.color;
-                         
-                         droppedMasks[i].active = false;
-                         DrawText("MASK EQUIPPED!", (int)player.position.x - 20, (int)player.position.y - 60, 10, GREEN);
                     } else {
-                         DrawText("INVENTORY FULL! DROP MASK (G + Num)", (int)player.position.x - 50, (int)player.position.y - 60, 10, RED);
+                         // Holding Knife (Slot 0) and Slots 1/2 are full.
+                         // Show UI "Inventory Full"? Or swap with Slot 1 by default?
+                         // User requirement implies Slot 0 is safe. We just don't pick up.
+                         DrawText("INVENTORY FULL - SWITCH WEAPON TO SWAP", (int)player.position.x - 60, (int)player.position.y - 50, 10, RED);
                     }
                 }
-            }
+            } break;
         }
     }
-    
+
     // Drop Mask (Vanish)
     if (IsKeyPressed(KEY_G)) {
         // Drops the currently active or selected mask slot
@@ -864,102 +1027,27 @@ static void UpdateGame(float dt) {
         }
     }
 
-    
-    // 5.5 Card Pickup
-    for (int i = 0; i < MAX_CARDS; i++) {
-        if (droppedCards[i].active) {
-            if (CheckCollisionCircles(player.position, player.radius, droppedCards[i].position, droppedCards[i].radius)) {
-                // Determine if this card is better than what we have
-                if (droppedCards[i].identity.permissionLevel > player.inventory.card.level) {
-                     DrawText("PRESS SPACE TO PICKUP KEYCARD", (int)player.position.x - 50, (int)player.position.y - 40, 10, WHITE);
-                     if (IsKeyPressed(KEY_SPACE)) {
-                         player.inventory.card.level = droppedCards[i].identity.permissionLevel;
-                         droppedCards[i].active = false;
-                         // Play pickup sound?
-                     }
-                } else {
-                    // Already have better or equal, maybe just auto-collect or ignore?
-                    // Let's ignore for now but maybe show "ALREADY HAVE ACCESS"
-                }
-            }
-        }
-    }
-
-    // 5.6 Gun Pickup
-    for (int i = 0; i < MAX_DROPPED_GUNS; i++) {
-        if (droppedGuns[i].active) {
-            if (CheckCollisionCircles(player.position, player.radius, droppedGuns[i].position, droppedGuns[i].radius)) {
-                DrawText("PRESS SPACE TO PICKUP GUN", (int)player.position.x - 50, (int)player.position.y - 40, 10, PINK);
-                if (IsKeyPressed(KEY_SPACE)) {
-                    // Try to find empty slot or a Knife slot to replace (SKIPPING SLOT 0)
-                    int emptySlot = -1;
-                    for (int s=1; s<MAX_GUN_SLOTS; s++) { // Start from 1
-                        if (player.inventory.gunSlots[s].type == GUN_NONE || player.inventory.gunSlots[s].type == GUN_KNIFE) {
-                            emptySlot = s;
-                            break;
-                        }
-                    }
-                    
-                    if (emptySlot != -1) {
-                        // Take it (Overwriting Knife/None in slot 1 or 2)
-                        player.inventory.gunSlots[emptySlot] = droppedGuns[i].gun;
-                        player.inventory.currentGunIndex = emptySlot; // Auto-switch?
-                        droppedGuns[i].active = false;
-                        PlaySound(fxReload); // Sound cue
-                    } else {
-                        // Swap with current if current is NOT Slot 0 and NOT a Knife
-                        if (player.inventory.currentGunIndex > 0) {
-                             Gun temp = player.inventory.gunSlots[player.inventory.currentGunIndex];
-                             
-                             if (temp.type != GUN_NONE && temp.type != GUN_KNIFE) {
-                                player.inventory.gunSlots[player.inventory.currentGunIndex] = droppedGuns[i].gun;
-                                
-                                droppedGuns[i].gun = temp; // Swap data
-                                droppedGuns[i].position = player.position; // Move drop to feet
-                             } else {
-                                 // Fallback (Shouldn't happen if emptySlot logic works)
-                                 player.inventory.gunSlots[player.inventory.currentGunIndex] = droppedGuns[i].gun;
-                                 droppedGuns[i].active = false;
-                             }
-                        } else {
-                             // Holding Knife (Slot 0) and Slots 1/2 are full.
-                             // Show UI "Inventory Full"? Or swap with Slot 1 by default?
-                             // User requirement implies Slot 0 is safe. We just don't pick up.
-                             DrawText("INVENTORY FULL - SWITCH WEAPON TO SWAP", (int)player.position.x - 60, (int)player.position.y - 50, 10, RED);
-                        }
-                    }
-                }
-            }
-        }
-    }
-    
     // 5.7 Manual Gun Drop (Key Q)
     if (IsKeyPressed(KEY_Q)) {
         int idx = player.inventory.currentGunIndex;
         Gun current = player.inventory.gunSlots[idx];
-        
+
         if (current.type != GUN_NONE && current.type != GUN_KNIFE) {
-            // Find spot in droppedGuns
-            for (int i=0; i<MAX_DROPPED_GUNS; i++) {
-                if (!droppedGuns[i].active) {
-                    droppedGuns[i].active = true;
-                    droppedGuns[i].position = player.position;
-                    // Offset slightly forward
-                    droppedGuns[i].position.x += 20 * player.identity.speed * dt * cosf(player.rotation * DEG2RAD);
-                    droppedGuns[i].position.y += 20 * player.identity.speed * dt * sinf(player.rotation * DEG2RAD);
-                    
-                    droppedGuns[i].radius = 15.0f;
-                    droppedGuns[i].gun = current;
-                    
-                    // Revert slot to Knife
-                    player.inventory.gunSlots[idx].type = GUN_KNIFE;
-                    player.inventory.gunSlots[idx].active = true;
-                    player.inventory.gunSlots[idx].damage = 50.0f;
-                    player.inventory.gunSlots[idx].range = 100.0f;
-                    player.inventory.gunSlots[idx].cooldown = 0.5f;
-                    
-                    break;
-                }
+            Vector2 dropPosition = player.position;
+            // Offset slightly forward
+            dropPosition.x += 20 * player.identity.speed * dt * cosf(player.rotation * DEG2RAD);
+            dropPosition.y += 20 * player.identity.speed * dt * sinf(player.rotation * DEG2RAD);
+
+            Pickup *drop = Pickups_Add(&pickups, PICKUP_GUN, dropPosition, 15.0f);
+            if (drop) {
+                drop->gun = current;
+
+                // Revert slot to Knife
+                player.inventory.gunSlots[idx].type = GUN_KNIFE;
+                player.inventory.gunSlots[idx].active = true;
+                player.inventory.gunSlots[idx].damage = 50.0f;
+                player.inventory.gunSlots[idx].range = 100.0f;
+                player.inventory.gunSlots[idx].cooldown = 0.5f;
             }
         }
     }
@@ -972,12 +1060,16 @@ static void UpdateGame(float dt) {
         if (developerMode) sufficientPerm = true; 
         
         if (CheckCollisionCircleRec(player.position, player.radius + 10.0f, currentLevel.doors[i].rect) && sufficientPerm) {
-            currentLevel.doors[i].isOpen = true;
+            if (!currentLevel.doors[i].isOpen) {
+                Rectangle r = currentLevel.doors[i].rect;
+                Noise_Emit(&noise, (Vector2){ r.x + r.width / 2, r.y + r.height / 2 }, NOISE_DOOR_LOUDNESS);
+            }
+            Level_SetDoorOpen(&currentLevel, i, true);
         } else {
             // Only close if player is far enough? Or auto close.
             // Simple auto - check if player is NOT in it.
             if (!CheckCollisionCircleRec(player.position, player.radius + 5.0f, currentLevel.doors[i].rect)) {
-                 currentLevel.doors[i].isOpen = false;
+                 Level_SetDoorOpen(&currentLevel, i, false);
             }
         }
         
@@ -997,6 +1089,9 @@ static void UpdateGame(float dt) {
     if (CheckCollisionCircleRec(player.position, player.radius + 10.0f, currentLevel.win_area)) {
         gameWon = true;
     }
+
+    Noise_Propagate(&noise, &currentLevel); // After the doors, so a door just opened lets sound through
+    UpdateEnemyVision();
 } // End UpdateGame
 
 static void DrawGame(void) {
@@ -1121,33 +1216,22 @@ static void DrawGame(void) {
 
         // Enemies
         for (int i = 0; i < currentLevel.enemyCount; i++) {
-            if (currentLevel.enemies[i].active) {
-                // Draw Vision Cone
-                float halfAngle = currentLevel.enemies[i].sightAngle / 2.0f;
-                Vector2 origin = currentLevel.enemies[i].position;
-                float startAngle = currentLevel.enemies[i].rotation - halfAngle;
-                float endAngle = currentLevel.enemies[i].rotation + halfAngle;
-                int segments = 30; 
-                float step = (endAngle - startAngle) / segments;
+            if (currentLevel.enemyBodies[i].active) {
+                const EntityBody *body = &currentLevel.enemyBodies[i];
+                const EnemyStats *stats = &currentLevel.enemyStats[i];
+                // Draw Vision Cone (visibility polygon from the last update)
+                const VisibilityPolygon *vision = &enemyVision[i];
+                Vector2 origin = vision->origin;
+                int outlineCount = Visibility_GetOutline(vision, visionOutline, VISIBILITY_MAX_POINTS + 2);
                 
                 rlSetTexture(0);
                 rlDisableBackfaceCulling(); // Ensure we see it regardless of winding
                 rlBegin(RL_TRIANGLES);
                 rlColor4ub(200, 200, 200, 60); // Light Gray, Semi-transparent
 
-                for (int s = 0; s < segments; s++) {
-                    float a1 = (startAngle + s * step) * DEG2RAD;
-                    float a2 = (startAngle + (s + 1) * step) * DEG2RAD;
-
-                    Vector2 d1 = { cosf(a1) * currentLevel.enemies[i].sightRange, sinf(a1) * currentLevel.enemies[i].sightRange };
-                    Vector2 d2 = { cosf(a2) * currentLevel.enemies[i].sightRange, sinf(a2) * currentLevel.enemies[i].sightRange };
-
-                    Vector2 p1 = Vector2Add(origin, d1);
-                    Vector2 p2 = Vector2Add(origin, d2);
-                    
-                    // Raycast against walls
-                    p1 = Gameplay_GetRayHit(origin, p1, &currentLevel);
-                    p2 = Gameplay_GetRayHit(origin, p2, &currentLevel);
+                for (int s = 0; s + 1 < outlineCount; s++) {
+                    Vector2 p1 = visionOutline[s];
+                    Vector2 p2 = visionOutline[s + 1];
 
                     // Draw Triangle (Origin -> P1 -> P2)
                     rlVertex2f(origin.x, origin.y);
@@ -1162,23 +1246,23 @@ static void DrawGame(void) {
                 rlEnd();
                 rlEnableBackfaceCulling(); // Reset default (though usually off in 2D)
 
-                DrawCircleV(currentLevel.enemies[i].position, currentLevel.enemies[i].radius, currentLevel.enemies[i].identity.color);
-                DrawCircleLines((int)currentLevel.enemies[i].position.x, (int)currentLevel.enemies[i].position.y, currentLevel.enemies[i].radius + 2, WHITE);
+                DrawCircleV(body->position, body->radius, currentLevel.enemyAI[i].identity.color);
+                DrawCircleLines((int)body->position.x, (int)body->position.y, body->radius + 2, WHITE);
                 
                 // HP Bar
-                float hpRatio = currentLevel.enemies[i].health / currentLevel.enemies[i].maxHealth;
+                float hpRatio = stats->health / stats->maxHealth;
                 if (hpRatio < 0.0f) hpRatio = 0.0f;
                 int barW = 40;
                 int barH = 5;
-                int barX = (int)currentLevel.enemies[i].position.x - barW/2;
-                int barY = (int)currentLevel.enemies[i].position.y - 30;
+                int barX = (int)body->position.x - barW/2;
+                int barY = (int)body->position.y - 30;
                 
                 DrawRectangle(barX, barY, barW, barH, RED);
                 DrawRectangle(barX, barY, (int)(barW * hpRatio), barH, GREEN);
                 DrawRectangleLines(barX, barY, barW, barH, BLACK);
                 
                 // Text
-                DrawText(TextFormat("%.0f", currentLevel.enemies[i].health), barX, barY - 10, 10, WHITE);
+                DrawText(TextFormat("%.0f", stats->health), barX, barY - 10, 10, WHITE);
             }
         }
 
@@ -1186,59 +1270,59 @@ static void DrawGame(void) {
         // --- Draw NPCs ---
         Npc_DrawAll(&currentLevel, &player);
 
-        // Mask
-        for (int i = 0; i < MAX_MASKS; i++) {
-            if (droppedMasks[i].active) {
-                // Draw Striped Pattern
-                Vector2 pos = droppedMasks[i].position;
-                float r = droppedMasks[i].radius;
-                Color col = droppedMasks[i].identity.color;
-                
-                DrawCircleV(pos, r, col);
-                DrawCircleLines((int)pos.x, (int)pos.y, r, WHITE);
-                
-                // Stripes (Diagonal)
-                rlPushMatrix();
-                rlTranslatef(pos.x, pos.y, 0);
-                rlRotatef(45.0f, 0, 0, 1);
-                DrawRectangle(-r, -r/2, r*2, 4, WHITE);
-                DrawRectangle(-r, 0, r*2, 4, WHITE);
-                DrawRectangle(-r, r/2, r*2, 4, WHITE);
-                rlPopMatrix();
-
-                DrawText("MASK", (int)pos.x - 10, (int)pos.y - 10, 8, BLACK);
-                DrawText("PRESS SPACE", (int)pos.x - 30, (int)pos.y - 30, 10, WHITE);
-            }
-        }
-
-        // Cards
-        for (int i = 0; i < MAX_CARDS; i++) {
-            if (droppedCards[i].active) {
-                // Draw a rectangle card
-                Rectangle cardRect = { droppedCards[i].position.x - 8, droppedCards[i].position.y - 5, 16, 10 };
-                DrawRectangleRec(cardRect, droppedCards[i].identity.color);
-                DrawRectangleLinesEx(cardRect, 1, WHITE);
-                DrawText("CARD", (int)droppedCards[i].position.x - 10, (int)droppedCards[i].position.y - 15, 8, WHITE);
-            }
-        }
-
-        // Dropped Guns
-        for (int i = 0; i < MAX_DROPPED_GUNS; i++) {
-            if (droppedGuns[i].active) {
-                // Determine text/color
-                Color gunCol = ORANGE;
-                const char* txt = "GUN";
-                if (droppedGuns[i].gun.type == GUN_HANDGUN) { txt = "Pistol"; gunCol = GOLD; }
-                else if (droppedGuns[i].gun.type == GUN_RIFLE) { txt = "Rifle"; gunCol = LIME; }
-                
-                DrawCircleV(droppedGuns[i].position, droppedGuns[i].radius, gunCol);
-                DrawText(txt, (int)droppedGuns[i].position.x - 20, (int)droppedGuns[i].position.y - 20, 10, WHITE);
+        // Pickups in view
+        Vector2 viewMin = GetScreenToWorld2D((Vector2){ 0, 0 }, camera);
+        Vector2 viewMax = GetScreenToWorld2D((Vector2){ (float)GetScreenWidth(), (float)GetScreenHeight() }, camera);
+        PickupIter pickupIt = Pickups_Query(&pickups, (Rectangle){ viewMin.x, viewMin.y, viewMax.x - viewMin.x, viewMax.y - viewMin.y });
+        int p;
+        while (PickupIter_Next(&pickupIt, &p)) {
+            Vector2 pos = pickups.bodies[p].position;
+            float r = pickups.bodies[p].radius;
+            const Pickup *pickup = &pickups.items[p];
+            switch (pickup->type) {
+                case PICKUP_MASK: {
+                    // Draw Striped Pattern
+                    DrawCircleV(pos, r, pickup->maskColor);
+                    DrawCircleLines((int)pos.x, (int)pos.y, r, WHITE);
+
+                    // Stripes (Diagonal)
+                    rlPushMatrix();
+                    rlTranslatef(pos.x, pos.y, 0);
+                    rlRotatef(45.0f, 0, 0, 1);
+                    DrawRectangle(-r, -r/2, r*2, 4, WHITE);
+                    DrawRectangle(-r, 0, r*2, 4, WHITE);
+                    DrawRectangle(-r, r/2, r*2, 4, WHITE);
+                    rlPopMatrix();
+
+                    DrawText("MASK", (int)pos.x - 10, (int)pos.y - 10, 8, BLACK);
+                    DrawText("PRESS SPACE", (int)pos.x - 30, (int)pos.y - 30, 10, WHITE);
+                } break;
+
+                case PICKUP_CARD: {
+                    // Draw a rectangle card
+                    Rectangle cardRect = { pos.x - 8, pos.y - 5, 16, 10 };
+                    DrawRectangleRec(cardRect, pickup->card.color);
+                    DrawRectangleLinesEx(cardRect, 1, WHITE);
+                    DrawText("CARD", (int)pos.x - 10, (int)pos.y - 15, 8, WHITE);
+                } break;
+
+                case PICKUP_GUN: {
+                    // Determine text/color
+                    Color gunCol = ORANGE;
+                    const char* txt = "GUN";
+                    if (pickup->gun.type == GUN_HANDGUN) { txt = "Pistol"; gunCol = GOLD; }
+                    else if (pickup->gun.type == GUN_RIFLE) { txt = "Rifle"; gunCol = LIME; }
+
+                    DrawCircleV(pos, r, gunCol);
+                    DrawText(txt, (int)pos.x - 20, (int)pos.y - 20, 10, WHITE);
+                } break;
             }
         }
 
         // Bullets
-        for (int i = 0; i < MAX_BULLETS; i++) {
-            if (bullets[i].active) DrawCircleV(bullets[i].position, bullets[i].radius, bullets[i].isPlayerOwned ? YELLOW : ORANGE);
+        for (int i = 0; i < bullets.count; i++) {
+            const Bullet *b = Pool_At(&bullets, i);
+            DrawCircleV(b->position, b->radius, b->isPlayerOwned ? YELLOW : ORANGE);
         }
 
         // Player
@@ -1251,7 +1335,8 @@ static void DrawGame(void) {
         }
 
         // Melee Prompt
-        if (meleeTargetIndex >= 0 && meleeTargetIndex < currentLevel.enemyCount && currentLevel.enemies[meleeTargetIndex].active) {
+        int meleeEnemy = Level_ResolveEnemy(&currentLevel, meleeTarget);
+        if (meleeEnemy >= 0 && currentLevel.enemyBodies[meleeEnemy].active) {
              DrawText("HOLD E TO CHOKE", (int)player.position.x - 40, (int)player.position.y - 60, 12, RED);
         }
 
@@ -1276,10 +1361,9 @@ static void DrawGame(void) {
         }
         
         // Draw Particles
-        for(int i=0; i<MAX_PARTICLES; i++) {
-            if(particles[i].active) {
-                DrawRectangleV(particles[i].position, (Vector2){particles[i].size, particles[i].size}, Fade(particles[i].color, particles[i].life));
-            }
+        for (int i = 0; i < particles.count; i++) {
+            const Particle *particle = Pool_At(&particles, i);
+            DrawRectangleV(particle->position, (Vector2){particle->size, particle->size}, Fade(particle->color, particle->life));
         }
         
         // Debug
@@ -1349,4 +1433,13 @@ void Game_Draw(void) {
 
 
 void Game_Shutdown(void) {
+    Jobs_Shutdown();
+    for (int i = 0; i < JOBS_MAX_WORKERS; i++) EnemyCommands_Free(&enemyCommands[i]);
+    Pool_Free(&bullets);
+    Pool_Free(&particles);
+    Pickups_Free(&pickups);
+    EnemyScheduler_Free(&enemyScheduler);
+    free(enemyVision);
+    free(enemyPaths);
+    UnloadLevel(&currentLevel);
 }
@@ -8,4 +8,11 @@ bool Game_Update(void);
 void Game_Draw(void);
 void Game_Shutdown(void); // Optional, for cleanup
 
+// Level editor hooks, called once the level's enemies have changed: keep the game's
+// per-enemy state (AI schedule, nav path, vision cone) with the enemy it belongs to.
+// On removal the enemies after `index` have moved down one. Adding returns false if out
+// of memory, the new enemy then has no game-side state and must be removed again.
+bool Game_OnEnemyAdded(int index);
+void Game_OnEnemyRemoved(int index);
+
 #endif // GAME_H
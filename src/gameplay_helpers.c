@@ -2,36 +2,16 @@
 #include "../raylib/src/raymath.h"
 #include <float.h>
 
+// SIMD level is picked by the compiler flags (see SIMD in the Makefile)
+#if defined(__AVX__)
+    #include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+    #include <emmintrin.h>
+#endif
+
 bool CheckCollisionCircleRotatedRect(Vector2 center, float radius, Rectangle rect, float rotation) {
-    // 1. Transform Circle Center to Local Space of the Rectangle
-    Vector2 rectCenter = { rect.x + rect.width / 2.0f, rect.y + rect.height / 2.0f };
-    
-    // Vector from rect center to circle center
-    Vector2 dir = Vector2Subtract(center, rectCenter);
-    
-    // Rotate this vector by -rotation (inverse rotation)
-    // Create rotation matrix / or just manual sin/cos
-    float rad = -rotation * DEG2RAD;
-    float s = sinf(rad);
-    float c = cosf(rad);
-    
-    Vector2 localDir = {
-        dir.x * c - dir.y * s,
-        dir.x * s + dir.y * c
-    };
-    
-    // Local Circle Center
-    Vector2 localCenter = Vector2Add(rectCenter, localDir); // Wait, no.
-    
-    // Actually, simpler:
-    // Just rotate the point (center) around (rectCenter) by -rotation.
-    // The AABB is axis aligned at 0 rotation centered at rectCenter.
-    // Wait, rect.x/y is top-left usually.
-    // Correct logic:
-    // 1. Center of rect
+    // Rotate 'center' around the rect center by -rotation, then test against the unrotated rect
     Vector2 origin = { rect.x + rect.width/2.0f, rect.y + rect.height/2.0f };
-    
-    // 2. Rotate 'center' around 'origin' by -rotation
     Vector2 diff = Vector2Subtract(center, origin);
     float r = -rotation * DEG2RAD;
     float cosA = cosf(r);
@@ -42,7 +22,6 @@ bool CheckCollisionCircleRotatedRect(Vector2 center, float radius, Rectangle rec
         diff.x * sinA + diff.y * cosA
     };
     
-    // 3. Now check AABB collision with localPos vs unrotated Rect centered at (0,0) with dims width/height
     // Since we rotated around center, the local rect is centered at (0,0)
     float halfW = rect.width / 2.0f;
     float halfH = rect.height / 2.0f;
@@ -59,6 +38,219 @@ bool CheckCollisionCircleRotatedRect(Vector2 center, float radius, Rectangle rec
     return distance < radius;
 }
 
+bool CheckCollisionCircleWallShape(Vector2 center, float radius, const WallShape *shape) {
+    // Project onto the wall axes (local space), no trig needed
+    Vector2 diff = Vector2Subtract(center, shape->center);
+    float localX = diff.x * shape->axisX.x + diff.y * shape->axisX.y;
+    float localY = diff.x * shape->axisY.x + diff.y * shape->axisY.y;
+
+    float dx = localX - fmaxf(-shape->halfExtents.x, fminf(localX, shape->halfExtents.x));
+    float dy = localY - fmaxf(-shape->halfExtents.y, fminf(localY, shape->halfExtents.y));
+    return dx*dx + dy*dy < radius*radius;
+}
+
+// Slab test of the segment start + delta*t, t in [0,1], against an axis-aligned box.
+// Writes the first boundary crossing (the exit if start is inside), like testing the 4 edges.
+static inline bool SegmentHitsBox(Vector2 start, Vector2 invDelta, Rectangle box, float *tHit) {
+    float tx1 = (box.x - start.x) * invDelta.x;
+    float tx2 = (box.x + box.width - start.x) * invDelta.x;
+    float ty1 = (box.y - start.y) * invDelta.y;
+    float ty2 = (box.y + box.height - start.y) * invDelta.y;
+
+    float tEnter = fmaxf(fminf(tx1, tx2), fminf(ty1, ty2));
+    float tExit = fminf(fmaxf(tx1, tx2), fmaxf(ty1, ty2));
+
+    float t = (tEnter >= 0.0f) ? tEnter : tExit;
+    *tHit = t;
+    return tEnter <= tExit && t >= 0.0f && t <= 1.0f;
+}
+
+// 1/delta per axis, with zero components nudged so the slab math stays finite
+static inline Vector2 SafeInverse(Vector2 delta) {
+    const float eps = 1e-8f;
+    float dx = (fabsf(delta.x) > eps) ? delta.x : copysignf(eps, delta.x);
+    float dy = (fabsf(delta.y) > eps) ? delta.y : copysignf(eps, delta.y);
+    return (Vector2){ 1.0f / dx, 1.0f / dy };
+}
+
+bool Gameplay_CircleHitsAnyBox(Vector2 center, float radius,
+                               const float *minX, const float *minY,
+                               const float *maxX, const float *maxY, int count) {
+    float r2 = radius * radius;
+    int i = 0;
+
+#if defined(__AVX__)
+    // 8 boxes per iteration
+    __m256 cx8 = _mm256_set1_ps(center.x);
+    __m256 cy8 = _mm256_set1_ps(center.y);
+    __m256 r28 = _mm256_set1_ps(r2);
+    __m256 zero8 = _mm256_setzero_ps();
+    for (; i + 8 <= count; i += 8) {
+        __m256 dx = _mm256_max_ps(_mm256_max_ps(_mm256_sub_ps(_mm256_loadu_ps(minX + i), cx8), zero8),
+                                  _mm256_sub_ps(cx8, _mm256_loadu_ps(maxX + i)));
+        __m256 dy = _mm256_max_ps(_mm256_max_ps(_mm256_sub_ps(_mm256_loadu_ps(minY + i), cy8), zero8),
+                                  _mm256_sub_ps(cy8, _mm256_loadu_ps(maxY + i)));
+        __m256 d2 = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+        if (_mm256_movemask_ps(_mm256_cmp_ps(d2, r28, _CMP_LT_OQ))) return true;
+    }
+#endif
+
+#if defined(__AVX__) || defined(__SSE2__) || defined(_M_X64)
+    // 4 boxes per iteration (also the AVX tail)
+    __m128 cx4 = _mm_set1_ps(center.x);
+    __m128 cy4 = _mm_set1_ps(center.y);
+    __m128 r24 = _mm_set1_ps(r2);
+    __m128 zero4 = _mm_setzero_ps();
+    for (; i + 4 <= count; i += 4) {
+        __m128 dx = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(minX + i), cx4), zero4),
+                               _mm_sub_ps(cx4, _mm_loadu_ps(maxX + i)));
+        __m128 dy = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(minY + i), cy4), zero4),
+                               _mm_sub_ps(cy4, _mm_loadu_ps(maxY + i)));
+        __m128 d2 = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        if (_mm_movemask_ps(_mm_cmplt_ps(d2, r24))) return true;
+    }
+#endif
+
+    // Scalar fallback / remainder: clamp distance with min/max only
+    for (; i < count; i++) {
+        float dx = fmaxf(fmaxf(minX[i] - center.x, 0.0f), center.x - maxX[i]);
+        float dy = fmaxf(fmaxf(minY[i] - center.y, 0.0f), center.y - maxY[i]);
+        if (dx*dx + dy*dy < r2) return true;
+    }
+    return false;
+}
+
+Rectangle Gameplay_CircleBounds(Vector2 center, float radius) {
+    return (Rectangle){ center.x - radius, center.y - radius, radius * 2.0f, radius * 2.0f };
+}
+
+bool Gameplay_CircleHitsWall(const Level *level, Vector2 center, float radius) {
+    Rectangle area = Gameplay_CircleBounds(center, radius);
+    const LevelGrid *grid = &level->grid;
+    int cx0, cy0, cx1, cy1;
+    if (!LevelGrid_GetCellRange(grid, area, &cx0, &cy0, &cx1, &cy1)) return false;
+
+    // Common case: plain boxes, tested in batches straight from the cell's SoA bounds
+    const int layer = GRID_LAYER_AABB_WALLS;
+    for (int cy = cy0; cy <= cy1; cy++) {
+        for (int cx = cx0; cx <= cx1; cx++) {
+            int c = cy * grid->cols + cx;
+            int first = grid->start[layer][c];
+            int count = grid->start[layer][c + 1] - first;
+            if (count > 0 && Gameplay_CircleHitsAnyBox(center, radius,
+                                                       &grid->minX[layer][first], &grid->minY[layer][first],
+                                                       &grid->maxX[layer][first], &grid->maxY[layer][first], count)) {
+                return true;
+            }
+        }
+    }
+
+    // Rotated walls need the full OBB test
+    int i;
+    LevelGridIter it = LevelGrid_Query(&level->grid, GRID_LAYER_OBB_WALLS, area);
+    while (LevelGridIter_Next(&it, &i)) {
+        if (CheckCollisionCircleWallShape(center, radius, &level->wallShapes[i])) return true;
+    }
+    return false;
+}
+
+// Earliest t in [0, limit) where start + delta*t is within `radius` of `center` (0 if it starts inside)
+static bool SweepPointCircle(Vector2 start, Vector2 delta, Vector2 center, float radius, float limit, float *toi) {
+    Vector2 m = Vector2Subtract(start, center);
+    float c = Vector2DotProduct(m, m) - radius * radius;
+    if (c <= 0.0f) { *toi = 0.0f; return true; }
+
+    float a = Vector2DotProduct(delta, delta);
+    float b = Vector2DotProduct(m, delta);
+    if (b >= 0.0f || a <= 0.0f) return false; // Moving away or not moving
+
+    float disc = b * b - a * c;
+    if (disc < 0.0f) return false;
+
+    float t = (-b - sqrtf(disc)) / a;
+    if (t >= limit) return false;
+    *toi = t;
+    return true;
+}
+
+// Swept circle vs axis-aligned box, i.e. segment vs the box rounded by `radius`.
+// Slab test against the box grown by radius, then corner regions are refined with the corner circle.
+static bool SweepCircleBox(Vector2 start, Vector2 delta, float radius, Rectangle box, float limit, float *toi) {
+    Rectangle grown = { box.x - radius, box.y - radius, box.width + radius * 2.0f, box.height + radius * 2.0f };
+    Vector2 inv = SafeInverse(delta);
+
+    float tx1 = (grown.x - start.x) * inv.x;
+    float tx2 = (grown.x + grown.width - start.x) * inv.x;
+    float ty1 = (grown.y - start.y) * inv.y;
+    float ty2 = (grown.y + grown.height - start.y) * inv.y;
+    float tEnter = fmaxf(fmaxf(fminf(tx1, tx2), fminf(ty1, ty2)), 0.0f);
+    float tExit = fminf(fmaxf(tx1, tx2), fmaxf(ty1, ty2));
+    if (tEnter > tExit || tEnter >= limit) return false;
+
+    // Entry point: inside the rounded shape unless it lies beyond the box on both axes
+    Vector2 p = Vector2Add(start, Vector2Scale(delta, tEnter));
+    bool outX = p.x < box.x || p.x > box.x + box.width;
+    bool outY = p.y < box.y || p.y > box.y + box.height;
+    if (!(outX && outY)) {
+        *toi = tEnter;
+        return true;
+    }
+
+    // Corner region: the rounded corner is the only surface reachable from here
+    Vector2 corner = {
+        (p.x < box.x) ? box.x : box.x + box.width,
+        (p.y < box.y) ? box.y : box.y + box.height
+    };
+    return SweepPointCircle(start, delta, corner, radius, limit, toi);
+}
+
+bool Gameplay_SweepCircleCircle(Vector2 start, Vector2 end, float radius, Vector2 center, float otherRadius, float *toi) {
+    return SweepPointCircle(start, Vector2Subtract(end, start), center, radius + otherRadius, *toi, toi);
+}
+
+bool Gameplay_SweepCircleWalls(const Level *level, Vector2 start, Vector2 end, float radius, float *toi) {
+    Vector2 delta = Vector2Subtract(end, start);
+    Rectangle area = {
+        fminf(start.x, end.x) - radius, fminf(start.y, end.y) - radius,
+        fabsf(delta.x) + radius * 2.0f, fabsf(delta.y) + radius * 2.0f
+    };
+    bool hit = false;
+    int i;
+
+    LevelGridIter it = LevelGrid_Query(&level->grid, GRID_LAYER_AABB_WALLS, area);
+    while (LevelGridIter_Next(&it, &i)) {
+        if (SweepCircleBox(start, delta, radius, level->wallShapes[i].bounds, *toi, toi)) hit = true;
+    }
+
+    // Rotated walls: sweep in the wall's local space, where it is a plain box
+    it = LevelGrid_Query(&level->grid, GRID_LAYER_OBB_WALLS, area);
+    while (LevelGridIter_Next(&it, &i)) {
+        const WallShape *w = &level->wallShapes[i];
+        Vector2 d = Vector2Subtract(start, w->center);
+        Vector2 localStart = { Vector2DotProduct(d, w->axisX), Vector2DotProduct(d, w->axisY) };
+        Vector2 localDelta = { Vector2DotProduct(delta, w->axisX), Vector2DotProduct(delta, w->axisY) };
+        Rectangle localBox = { -w->halfExtents.x, -w->halfExtents.y, w->halfExtents.x * 2.0f, w->halfExtents.y * 2.0f };
+        if (SweepCircleBox(localStart, localDelta, radius, localBox, *toi, toi)) hit = true;
+    }
+    return hit;
+}
+
+bool Gameplay_SweepCircleClosedDoors(const Level *level, Vector2 start, Vector2 end, float radius, float *toi) {
+    Vector2 delta = Vector2Subtract(end, start);
+    Rectangle area = {
+        fminf(start.x, end.x) - radius, fminf(start.y, end.y) - radius,
+        fabsf(delta.x) + radius * 2.0f, fabsf(delta.y) + radius * 2.0f
+    };
+    bool hit = false;
+    int i;
+
+    LevelGridIter it = LevelGrid_Query(&level->grid, GRID_LAYER_DOORS, area);
+    while (LevelGridIter_Next(&it, &i)) {
+        if (level->doors[i].isOpen) continue;
+        if (SweepCircleBox(start, delta, radius, level->doors[i].rect, *toi, toi)) hit = true;
+    }
+    return hit;
+}
 
 int Gameplay_GetClosestDoor(const Level *level, Vector2 position) {
     if (!level) return -1;
@@ -77,136 +269,92 @@ int Gameplay_GetClosestDoor(const Level *level, Vector2 position) {
     return closest;
 }
 
+// Tests the segment against every wall/closed door binned in grid cell c,
+// lowering *best (fraction of the segment) on closer hits.
+static void RayTestCell(const Level *level, int c, Vector2 start, Vector2 delta, Vector2 invDelta, float *best) {
+    const LevelGrid *grid = &level->grid;
+    float t;
+
+    // Axis-aligned walls: slab test straight from the cell's SoA bounds
+    const int aabb = GRID_LAYER_AABB_WALLS;
+    for (int r = grid->start[aabb][c]; r < grid->start[aabb][c + 1]; r++) {
+        Rectangle box = { grid->minX[aabb][r], grid->minY[aabb][r],
+                          grid->maxX[aabb][r] - grid->minX[aabb][r], grid->maxY[aabb][r] - grid->minY[aabb][r] };
+        if (SegmentHitsBox(start, invDelta, box, &t) && t < *best) *best = t;
+    }
+
+    // Rotated walls: same slab test in the wall's local space (rotation keeps t)
+    const int obb = GRID_LAYER_OBB_WALLS;
+    for (int r = grid->start[obb][c]; r < grid->start[obb][c + 1]; r++) {
+        const WallShape *w = &level->wallShapes[grid->refs[obb][r]];
+        Vector2 d = Vector2Subtract(start, w->center);
+        Vector2 localStart = { Vector2DotProduct(d, w->axisX), Vector2DotProduct(d, w->axisY) };
+        Vector2 localDelta = { Vector2DotProduct(delta, w->axisX), Vector2DotProduct(delta, w->axisY) };
+        Rectangle localBox = { -w->halfExtents.x, -w->halfExtents.y, w->halfExtents.x * 2.0f, w->halfExtents.y * 2.0f };
+        if (SegmentHitsBox(localStart, SafeInverse(localDelta), localBox, &t) && t < *best) *best = t;
+    }
+
+    // Closed doors (grid bounds are padded, test the real rect)
+    const int doors = GRID_LAYER_DOORS;
+    for (int r = grid->start[doors][c]; r < grid->start[doors][c + 1]; r++) {
+        const Door *door = &level->doors[grid->refs[doors][r]];
+        if (door->isOpen) continue;
+        if (SegmentHitsBox(start, invDelta, door->rect, &t) && t < *best) *best = t;
+    }
+}
+
 Vector2 Gameplay_GetRayHit(Vector2 start, Vector2 end, const Level *level) {
     if (!level) return end;
 
-    Vector2 closestHit = end;
-    float closestDistSq = Vector2DistanceSqr(start, end);
-
-    // Walls
-    for (int i = 0; i < level->wallCount; i++) {
-        // Simple AABB raycast if rotation is 0, else OBB
-        // For now, let's just do segments of the OBB?
-        // Or transform ray to local space?
-        
-        Wall w = level->walls[i];
-        
-        // Transform Ray to Local Space of Wall
-        Vector2 origin = { w.rect.x + w.rect.width/2.0f, w.rect.y + w.rect.height/2.0f };
-        float r = -w.rotation * DEG2RAD;
-        float c = cosf(r);
-        float s = sinf(r);
-        
-        // Transform Start
-        Vector2 dS = Vector2Subtract(start, origin);
-        Vector2 localStart = { dS.x * c - dS.y * s, dS.x * s + dS.y * c };
-        
-        // Transform End (Using Direction)
-        Vector2 dE = Vector2Subtract(end, origin); // Actually we need ray direction
-        // Let's just transform both points
-        Vector2 localEnd = { dE.x * c - dE.y * s, dE.x * s + dE.y * c };
-        
-        // Local Rect (Centered at 0,0)
-        Rectangle localRectIndices = { -w.rect.width/2.0f, -w.rect.height/2.0f, w.rect.width, w.rect.height };
-        
-        // Define standard 4 segments of AABB
-        Vector2 p1 = { localRectIndices.x, localRectIndices.y };
-        Vector2 p2 = { localRectIndices.x + localRectIndices.width, localRectIndices.y };
-        Vector2 p3 = { localRectIndices.x + localRectIndices.width, localRectIndices.y + localRectIndices.height };
-        Vector2 p4 = { localRectIndices.x, localRectIndices.y + localRectIndices.height };
-        
-        // Check intersections with ray (localStart -> localEnd)
-        Vector2 hit;
-        
-        if (CheckCollisionLines(localStart, localEnd, p1, p2, &hit)) {
-            // Transform hit back to world?
-            // Easier: just check distance in local space? Yes.
-            float d2 = Vector2DistanceSqr(localStart, hit);
-            if (d2 < closestDistSq) { 
-                // Transform hit back
-                /* 
-                   Local = Rot(-A) * (World - Origin)
-                   World - Origin = Rot(A) * Local
-                   World = Origin + Rot(A) * Local
-                */
-                // float backR = w.rotation * DEG2RAD; ...
-                // Actually, let's just update valid closestDistSq
-                closestDistSq = d2;
-                
-                // Calculate world hit
-                 float r2 = w.rotation * DEG2RAD;
-                 float c2 = cosf(r2);
-                 float s2 = sinf(r2);
-                 closestHit.x = origin.x + (hit.x * c2 - hit.y * s2);
-                 closestHit.y = origin.y + (hit.x * s2 + hit.y * c2);
-            }
-        }
-        if (CheckCollisionLines(localStart, localEnd, p2, p3, &hit)) {
-             float d2 = Vector2DistanceSqr(localStart, hit);
-             if (d2 < closestDistSq) {
-                 closestDistSq = d2;
-                 float r2 = w.rotation * DEG2RAD;
-                 float c2 = cosf(r2);
-                 float s2 = sinf(r2);
-                 closestHit.x = origin.x + (hit.x * c2 - hit.y * s2);
-                 closestHit.y = origin.y + (hit.x * s2 + hit.y * c2);
-             }
-        }
-        if (CheckCollisionLines(localStart, localEnd, p3, p4, &hit)) {
-             float d2 = Vector2DistanceSqr(localStart, hit);
-             if (d2 < closestDistSq) {
-                 closestDistSq = d2;
-                 float r2 = w.rotation * DEG2RAD;
-                 float c2 = cosf(r2);
-                 float s2 = sinf(r2);
-                 closestHit.x = origin.x + (hit.x * c2 - hit.y * s2);
-                 closestHit.y = origin.y + (hit.x * s2 + hit.y * c2);
-             }
-        }
-        if (CheckCollisionLines(localStart, localEnd, p4, p1, &hit)) {
-            float d2 = Vector2DistanceSqr(localStart, hit);
-             if (d2 < closestDistSq) {
-                 closestDistSq = d2;
-                 float r2 = w.rotation * DEG2RAD;
-                 float c2 = cosf(r2);
-                 float s2 = sinf(r2);
-                 closestHit.x = origin.x + (hit.x * c2 - hit.y * s2);
-                 closestHit.y = origin.y + (hit.x * s2 + hit.y * c2);
-             }
-        }
-    }
+    const LevelGrid *grid = &level->grid;
+    if (grid->cols <= 0 || grid->rows <= 0) return end;
 
-    // Doors (Keep as AABB for now or update similarly?)
-    // Doors in level struct are `Door doors[MAX]`. 
-    // They have simple `rect`.
-    // Assuming Doors don't rotate for now? Or do they?
-    // "add a wall struct and rearrange" -> mostly walls.
-    // Let's keep doors as AABB CheckCollisionLines for now.
-    for (int i = 0; i < level->doorCount; i++) {
-        Rectangle rec = level->doors[i].rect;
-            int doorIdx = i; // ...
-            if (level->doors[doorIdx].isOpen) continue;
-            
-             // AABB segments
-             Vector2 p1 = { rec.x, rec.y };
-             Vector2 p2 = { rec.x + rec.width, rec.y };
-             Vector2 p3 = { rec.x + rec.width, rec.y + rec.height };
-             Vector2 p4 = { rec.x, rec.y + rec.height };
-             
-             Vector2 hit;
-             if (CheckCollisionLines(start, end, p1, p2, &hit)) {
-                 if (Vector2DistanceSqr(start, hit) < closestDistSq) { closestHit = hit; closestDistSq = Vector2DistanceSqr(start, hit); }
-             }
-             if (CheckCollisionLines(start, end, p2, p3, &hit)) {
-                 if (Vector2DistanceSqr(start, hit) < closestDistSq) { closestHit = hit; closestDistSq = Vector2DistanceSqr(start, hit); }
-             }
-             if (CheckCollisionLines(start, end, p3, p4, &hit)) {
-                 if (Vector2DistanceSqr(start, hit) < closestDistSq) { closestHit = hit; closestDistSq = Vector2DistanceSqr(start, hit); }
-             }
-             if (CheckCollisionLines(start, end, p4, p1, &hit)) {
-                 if (Vector2DistanceSqr(start, hit) < closestDistSq) { closestHit = hit; closestDistSq = Vector2DistanceSqr(start, hit); }
-             }
+    Vector2 delta = Vector2Subtract(end, start);
+    Vector2 invDelta = SafeInverse(delta);
+
+    // Clip the segment to the grid, nothing can be hit outside it
+    float cs = grid->cellSize;
+    float tx1 = (grid->origin.x - start.x) * invDelta.x;
+    float tx2 = (grid->origin.x + grid->cols * cs - start.x) * invDelta.x;
+    float ty1 = (grid->origin.y - start.y) * invDelta.y;
+    float ty2 = (grid->origin.y + grid->rows * cs - start.y) * invDelta.y;
+    float tMin = fmaxf(fmaxf(fminf(tx1, tx2), fminf(ty1, ty2)), 0.0f);
+    float tMax = fminf(fminf(fmaxf(tx1, tx2), fmaxf(ty1, ty2)), 1.0f);
+    if (tMin > tMax) return end;
+
+    // Grid DDA: visit cells in the order the segment crosses them
+    Vector2 entry = Vector2Add(start, Vector2Scale(delta, tMin));
+    int cx = (int)floorf((entry.x - grid->origin.x) / cs);
+    int cy = (int)floorf((entry.y - grid->origin.y) / cs);
+    if (cx < 0) cx = 0; else if (cx >= grid->cols) cx = grid->cols - 1;
+    if (cy < 0) cy = 0; else if (cy >= grid->rows) cy = grid->rows - 1;
+
+    int stepX = (invDelta.x > 0.0f) ? 1 : -1;
+    int stepY = (invDelta.y > 0.0f) ? 1 : -1;
+    float tNextX = (grid->origin.x + (cx + (stepX > 0)) * cs - start.x) * invDelta.x;
+    float tNextY = (grid->origin.y + (cy + (stepY > 0)) * cs - start.y) * invDelta.y;
+    float tStepX = cs * fabsf(invDelta.x);
+    float tStepY = cs * fabsf(invDelta.y);
+
+    float best = FLT_MAX;
+    for (;;) {
+        RayTestCell(level, cy * grid->cols + cx, start, delta, invDelta, &best);
+
+        // Anything in later cells is hit after this cell's exit, so a hit before it is final
+        float tCellExit = fminf(tNextX, tNextY);
+        if (best <= tCellExit || tCellExit > tMax) break;
+
+        if (tNextX < tNextY) {
+            cx += stepX;
+            tNextX += tStepX;
+            if (cx < 0 || cx >= grid->cols) break;
+        } else {
+            cy += stepY;
+            tNextY += tStepY;
+            if (cy < 0 || cy >= grid->rows) break;
+        }
     }
 
-    return closestHit;
+    if (best > 1.0f) return end;
+    return Vector2Add(start, Vector2Scale(delta, best));
 }
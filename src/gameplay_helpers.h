@@ -8,6 +8,13 @@
 // Gameplay helpers used by the main loop.
 
 
+// Swept circle tests (bullets): the circle moves from start to end.
+// *toi is in/out: pass the latest time to consider (1.0f for the whole move); on hit it is
+// lowered to the earliest time of impact in [0, 1] (0 if already overlapping at start).
+bool Gameplay_SweepCircleWalls(const Level *level, Vector2 start, Vector2 end, float radius, float *toi);
+bool Gameplay_SweepCircleClosedDoors(const Level *level, Vector2 start, Vector2 end, float radius, float *toi);
+bool Gameplay_SweepCircleCircle(Vector2 start, Vector2 end, float radius, Vector2 center, float otherRadius, float *toi);
+
 int Gameplay_GetClosestDoor(const Level *level, Vector2 position);
 
 // Raycasts against walls/doors and returns the hit point (or end if no hit)
@@ -16,4 +23,19 @@ Vector2 Gameplay_GetRayHit(Vector2 start, Vector2 end, const Level *level);
 // Rotated Rectangle Collision
 bool CheckCollisionCircleRotatedRect(Vector2 center, float radius, Rectangle rect, float rotation);
 
+// Same test against a baked wall (no trig)
+bool CheckCollisionCircleWallShape(Vector2 center, float radius, const WallShape *shape);
+
+// Bounding box of a circle, for broadphase queries on level->grid
+Rectangle Gameplay_CircleBounds(Vector2 center, float radius);
+
+// Tests one circle against `count` axis-aligned boxes given as structure-of-arrays.
+// Runs 8 (AVX) or 4 (SSE) boxes per instruction when the build enables them, scalar otherwise.
+bool Gameplay_CircleHitsAnyBox(Vector2 center, float radius,
+                               const float *minX, const float *minY,
+                               const float *maxX, const float *maxY, int count);
+
+// True if the circle overlaps any wall (only nearby walls are tested)
+bool Gameplay_CircleHitsWall(const Level *level, Vector2 center, float radius);
+
 #endif // GAMEPLAY_HELPERS_H
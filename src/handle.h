@@ -0,0 +1,27 @@
+#ifndef HANDLE_H
+#define HANDLE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Generational reference to an enemy (Level_EnemyHandle), which the editor can remove
+// or move to another slot. It names a slot plus the generation the slot had when the
+// handle was taken; removing or moving the enemy gives the slot a new generation, so a
+// stale handle is caught in O(1) instead of silently pointing at whatever took its place.
+
+typedef struct {
+    uint32_t index;      // Slot
+    uint32_t generation; // Never 0 for a live element
+} Handle;
+
+#define HANDLE_NONE ((Handle){ 0, 0 })
+
+static inline bool Handle_IsNone(Handle handle) {
+    return handle.generation == 0;
+}
+
+static inline bool Handle_Equals(Handle a, Handle b) {
+    return a.index == b.index && a.generation == b.generation;
+}
+
+#endif // HANDLE_H
@@ -0,0 +1,127 @@
+#include "jobs.h"
+#include "../raylib/src/raylib.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#if !defined(_WIN32)
+#include <unistd.h>
+#endif
+
+static pthread_t threads[JOBS_MAX_WORKERS];
+static int workerCount = 1; // Main thread included
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t wake = PTHREAD_COND_INITIALIZER;     // Workers: a new job or quit
+static pthread_cond_t finished = PTHREAD_COND_INITIALIZER; // Main thread: all workers done
+
+// Current job, written under the lock before the workers are woken
+static JobFunc jobFunc;
+static void *jobCtx;
+static int jobCount;
+static int jobBatch;
+static atomic_int nextBatch;
+static unsigned int generation; // Bumped for every job
+static int running;             // Workers not done with the current job
+static bool quitting;
+
+static int CountCores(void) {
+#if defined(_WIN32)
+    return pthread_num_processors_np();
+#else
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return (n > 0) ? (int)n : 1;
+#endif
+}
+
+// Claims and runs batches until none are left
+static void RunBatches(int worker) {
+    for (;;) {
+        int begin = atomic_fetch_add_explicit(&nextBatch, 1, memory_order_relaxed) * jobBatch;
+        if (begin >= jobCount) break;
+        int end = (jobCount - begin > jobBatch) ? begin + jobBatch : jobCount;
+        jobFunc(jobCtx, begin, end, worker);
+    }
+}
+
+static void *WorkerMain(void *arg) {
+    int worker = (int)(intptr_t)arg;
+    unsigned int seen = 0;
+
+    pthread_mutex_lock(&lock);
+    for (;;) {
+        while (generation == seen && !quitting) pthread_cond_wait(&wake, &lock);
+        if (quitting) break;
+        seen = generation;
+        pthread_mutex_unlock(&lock);
+
+        RunBatches(worker);
+
+        pthread_mutex_lock(&lock);
+        if (--running == 0) pthread_cond_signal(&finished);
+    }
+    pthread_mutex_unlock(&lock);
+    return NULL;
+}
+
+void Jobs_Init(void) {
+    if (workerCount > 1) return;
+
+    int wanted = CountCores();
+    if (wanted > JOBS_MAX_WORKERS) wanted = JOBS_MAX_WORKERS;
+    quitting = false;
+    for (int i = 1; i < wanted; i++) {
+        if (pthread_create(&threads[i], NULL, WorkerMain, (void *)(intptr_t)i) != 0) {
+            TraceLog(LOG_WARNING, "Failed to start worker thread %d, using %d", i, workerCount);
+            break;
+        }
+        workerCount++;
+    }
+    TraceLog(LOG_INFO, "Jobs: %d threads", workerCount);
+}
+
+int Jobs_WorkerCount(void) {
+    return workerCount;
+}
+
+int Jobs_SplitBatch(int count, int minBatch) {
+    int batch = (count + workerCount - 1) / workerCount;
+    return (batch > minBatch) ? batch : minBatch;
+}
+
+void Jobs_Run(JobFunc func, void *ctx, int count, int batch) {
+    if (count <= 0) return;
+    if (batch < 1) batch = 1;
+    if (workerCount == 1 || count <= batch) {
+        func(ctx, 0, count, 0); // Not worth waking anyone
+        return;
+    }
+
+    pthread_mutex_lock(&lock);
+    jobFunc = func;
+    jobCtx = ctx;
+    jobCount = count;
+    jobBatch = batch;
+    atomic_store_explicit(&nextBatch, 0, memory_order_relaxed);
+    running = workerCount - 1;
+    generation++;
+    pthread_cond_broadcast(&wake);
+    pthread_mutex_unlock(&lock);
+
+    RunBatches(0);
+
+    pthread_mutex_lock(&lock);
+    while (running > 0) pthread_cond_wait(&finished, &lock);
+    pthread_mutex_unlock(&lock);
+}
+
+void Jobs_Shutdown(void) {
+    if (workerCount == 1) return;
+
+    pthread_mutex_lock(&lock);
+    quitting = true;
+    pthread_cond_broadcast(&wake);
+    pthread_mutex_unlock(&lock);
+
+    for (int i = 1; i < workerCount; i++) pthread_join(threads[i], NULL);
+    workerCount = 1;
+}
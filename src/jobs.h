@@ -0,0 +1,32 @@
+#ifndef JOBS_H
+#define JOBS_H
+
+// Worker threads for data-parallel loops over the level (one per core, capped).
+// Jobs_Run cuts [0, count) into batches that the workers and the calling thread
+// claim in increasing order, and returns once every batch is done. A batch runs
+// whole on one thread, so a thread's batches are visited in index order; `worker`
+// (0 = calling thread) picks that thread's scratch, e.g. a command buffer.
+// Jobs_Run must only be called from the main thread.
+
+#define JOBS_MAX_WORKERS 16
+
+typedef void (*JobFunc)(void *ctx, int begin, int end, int worker);
+
+// Starts the worker threads (falls back to the main thread alone if it can't)
+void Jobs_Init(void);
+
+// Threads taking part in a job, the main thread included (at least 1)
+int Jobs_WorkerCount(void);
+
+// Runs func over [0, count) in batches of `batch` items and waits for it.
+// Small jobs (a single batch) run directly on the calling thread.
+void Jobs_Run(JobFunc func, void *ctx, int count, int batch);
+
+// Batch size that gives each thread one share of `count` items, but never fewer
+// than `minBatch` (below that, waking a worker costs more than it saves)
+int Jobs_SplitBatch(int count, int minBatch);
+
+// Stops and joins the worker threads
+void Jobs_Shutdown(void);
+
+#endif // JOBS_H
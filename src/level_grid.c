@@ -0,0 +1,200 @@
+#include "level_grid.h"
+#include <math.h>
+
+static int ClampInt(int v, int lo, int hi) {
+    if (v < lo) return lo;
+    if (v > hi) return hi;
+    return v;
+}
+
+bool LevelGrid_GetCellRange(const LevelGrid *grid, Rectangle area, int *cx0, int *cy0, int *cx1, int *cy1) {
+    if (grid->cols <= 0 || grid->rows <= 0) return false;
+    if (area.width < 0.0f || area.height < 0.0f) return false;
+
+    float inv = 1.0f / grid->cellSize;
+    int x0 = (int)floorf((area.x - grid->origin.x) * inv);
+    int y0 = (int)floorf((area.y - grid->origin.y) * inv);
+    int x1 = (int)floorf((area.x + area.width - grid->origin.x) * inv);
+    int y1 = (int)floorf((area.y + area.height - grid->origin.y) * inv);
+
+    if (x1 < 0 || y1 < 0 || x0 >= grid->cols || y0 >= grid->rows) return false;
+
+    *cx0 = ClampInt(x0, 0, grid->cols - 1);
+    *cy0 = ClampInt(y0, 0, grid->rows - 1);
+    *cx1 = ClampInt(x1, 0, grid->cols - 1);
+    *cy1 = ClampInt(y1, 0, grid->rows - 1);
+    return true;
+}
+
+// Counts (fill == false) or writes (fill == true) the refs of one layer.
+// Returns the number of refs.
+static int FillLayer(LevelGrid *grid, GridLayer layer, const Rectangle *items, int count, bool fill) {
+    int cellCount = grid->cols * grid->rows;
+    int *start = grid->start[layer];
+
+    if (!fill) {
+        for (int c = 0; c <= cellCount; c++) start[c] = 0;
+    }
+
+    int total = 0;
+    for (int i = 0; i < count; i++) {
+        int cx0, cy0, cx1, cy1;
+        if (!LevelGrid_GetCellRange(grid, items[i], &cx0, &cy0, &cx1, &cy1)) continue;
+        for (int cy = cy0; cy <= cy1; cy++) {
+            for (int cx = cx0; cx <= cx1; cx++) {
+                int c = cy * grid->cols + cx;
+                if (fill) {
+                    // start[c + 1] is used as the write cursor, see LevelGrid_Build
+                    int ref = start[c + 1]++;
+                    grid->refs[layer][ref] = i;
+                    grid->minX[layer][ref] = items[i].x;
+                    grid->minY[layer][ref] = items[i].y;
+                    grid->maxX[layer][ref] = items[i].x + items[i].width;
+                    grid->maxY[layer][ref] = items[i].y + items[i].height;
+                } else {
+                    start[c + 1]++;
+                }
+                total++;
+            }
+        }
+    }
+
+    if (!fill) {
+        for (int c = 0; c < cellCount; c++) start[c + 1] += start[c];
+    }
+    return total;
+}
+
+// Capacity for `needed` items, doubling so a slowly growing level (editor) rarely reallocates
+static int GrownCapacity(int capacity, int needed) {
+    return (needed > capacity * 2) ? needed : capacity * 2;
+}
+
+static bool ReserveCells(LevelGrid *grid, Arena *arena, int cellCount) {
+    if (cellCount <= grid->cellCapacity) return true;
+    int capacity = GrownCapacity(grid->cellCapacity, cellCount);
+    for (int l = 0; l < GRID_LAYER_COUNT; l++) {
+        int *start = (int *)Arena_Alloc(arena, sizeof(int) * (size_t)(capacity + 1));
+        if (!start) return false;
+        grid->start[l] = start;
+    }
+    grid->cellCapacity = capacity;
+    return true;
+}
+
+static bool ReserveRefs(LevelGrid *grid, Arena *arena, GridLayer layer, int refCount) {
+    if (refCount <= grid->refCapacity[layer]) return true;
+    int capacity = GrownCapacity(grid->refCapacity[layer], refCount);
+    int *refs = (int *)Arena_Alloc(arena, sizeof(int) * (size_t)capacity);
+    float *minX = (float *)Arena_Alloc(arena, sizeof(float) * (size_t)capacity);
+    float *minY = (float *)Arena_Alloc(arena, sizeof(float) * (size_t)capacity);
+    float *maxX = (float *)Arena_Alloc(arena, sizeof(float) * (size_t)capacity);
+    float *maxY = (float *)Arena_Alloc(arena, sizeof(float) * (size_t)capacity);
+    if (!refs || !minX || !minY || !maxX || !maxY) return false;
+    grid->refs[layer] = refs;
+    grid->minX[layer] = minX;
+    grid->minY[layer] = minY;
+    grid->maxX[layer] = maxX;
+    grid->maxY[layer] = maxY;
+    grid->refCapacity[layer] = capacity;
+    return true;
+}
+
+bool LevelGrid_Build(LevelGrid *grid, Arena *arena, const Rectangle *items[GRID_LAYER_COUNT], const int counts[GRID_LAYER_COUNT]) {
+    grid->cols = 0;
+    grid->rows = 0;
+    grid->cellSize = LEVEL_GRID_CELL_SIZE;
+    grid->origin = (Vector2){0};
+
+    // World bounds of everything we index
+    bool any = false;
+    float minX = 0, minY = 0, maxX = 0, maxY = 0;
+    for (int l = 0; l < GRID_LAYER_COUNT; l++) {
+        for (int i = 0; i < counts[l]; i++) {
+            Rectangle r = items[l][i];
+            if (r.width < 0.0f || r.height < 0.0f) continue;
+            if (!any) {
+                minX = r.x; minY = r.y; maxX = r.x + r.width; maxY = r.y + r.height;
+                any = true;
+            } else {
+                minX = fminf(minX, r.x);
+                minY = fminf(minY, r.y);
+                maxX = fmaxf(maxX, r.x + r.width);
+                maxY = fmaxf(maxY, r.y + r.height);
+            }
+        }
+    }
+    if (!any) return true;
+
+    grid->origin = (Vector2){ minX, minY };
+
+    for (;;) {
+        grid->cols = (int)floorf((maxX - minX) / grid->cellSize) + 1;
+        grid->rows = (int)floorf((maxY - minY) / grid->cellSize) + 1;
+        if (grid->cols * grid->rows <= LEVEL_GRID_MAX_CELLS) break;
+        grid->cellSize *= 2.0f;
+    }
+
+    int cellCount = grid->cols * grid->rows;
+    bool allocated = ReserveCells(grid, arena, cellCount);
+    for (int l = 0; l < GRID_LAYER_COUNT && allocated; l++) {
+        int refCount = FillLayer(grid, (GridLayer)l, items[l], counts[l], false);
+        allocated = ReserveRefs(grid, arena, (GridLayer)l, refCount);
+    }
+    if (!allocated) {
+        TraceLog(LOG_WARNING, "Failed to allocate the level grid (%d cells)", cellCount);
+        grid->cols = 0;
+        grid->rows = 0;
+        return false;
+    }
+
+    for (int l = 0; l < GRID_LAYER_COUNT; l++) {
+        // Shift offsets up by one so start[c + 1] starts as the write cursor of cell c.
+        // After filling, start[c + 1] has advanced to the end of cell c, restoring the layout.
+        int *start = grid->start[l];
+        for (int c = cellCount; c > 0; c--) start[c] = start[c - 1];
+        start[0] = 0;
+        FillLayer(grid, (GridLayer)l, items[l], counts[l], true);
+    }
+    return true;
+}
+
+LevelGridIter LevelGrid_Query(const LevelGrid *grid, GridLayer layer, Rectangle area) {
+    LevelGridIter it = { .grid = grid, .layer = layer };
+    int cx0, cy0, cx1, cy1;
+    if (!LevelGrid_GetCellRange(grid, area, &cx0, &cy0, &cx1, &cy1)) {
+        // Empty range: Next() fails immediately
+        it.cy = 1;
+        it.cy1 = 0;
+        return it;
+    }
+
+    it.cx0 = cx0;
+    it.cx1 = cx1;
+    it.cy1 = cy1;
+    it.cx = cx0;
+    it.cy = cy0;
+    int c = cy0 * grid->cols + cx0;
+    it.ref = grid->start[layer][c];
+    it.refEnd = grid->start[layer][c + 1];
+    return it;
+}
+
+bool LevelGridIter_Next(LevelGridIter *it, int *index) {
+    while (it->cy <= it->cy1) {
+        if (it->ref < it->refEnd) {
+            *index = it->grid->refs[it->layer][it->ref++];
+            return true;
+        }
+
+        // Advance to next cell in the range
+        if (++it->cx > it->cx1) {
+            it->cx = it->cx0;
+            if (++it->cy > it->cy1) break;
+        }
+        int c = it->cy * it->grid->cols + it->cx;
+        it->ref = it->grid->start[it->layer][c];
+        it->refEnd = it->grid->start[it->layer][c + 1];
+    }
+    return false;
+}
@@ -0,0 +1,68 @@
+#ifndef LEVEL_GRID_H
+#define LEVEL_GRID_H
+
+#include "../raylib/src/raylib.h"
+#include "arena.h"
+#include <stdbool.h>
+
+// Uniform broadphase grid over static level geometry.
+// Each layer (axis-aligned walls, rotated walls, doors) stores, per cell, the
+// indices of the items whose world AABB touches that cell. Built once at level
+// load, queried by movement, bullets and raycasts so they only test nearby geometry.
+// Its arrays are sized to the level and allocated from the level's arena.
+
+#define LEVEL_GRID_CELL_SIZE 128.0f
+#define LEVEL_GRID_MAX_CELLS 4096 // Past this the cells get bigger instead
+
+typedef enum {
+    GRID_LAYER_AABB_WALLS = 0, // Walls with rotation in 90 degree steps
+    GRID_LAYER_OBB_WALLS,      // Truly rotated walls
+    GRID_LAYER_DOORS,
+    GRID_LAYER_COUNT
+} GridLayer;
+
+typedef struct {
+    Vector2 origin;
+    float cellSize;
+    int cols;
+    int rows;
+
+    // Cell c of a layer owns refs[layer][start[layer][c] .. start[layer][c + 1])
+    int *start[GRID_LAYER_COUNT];
+    int *refs[GRID_LAYER_COUNT];
+
+    // Bounds of each ref's item as structure-of-arrays, so a cell's candidates
+    // are contiguous and can be tested several at a time (see Gameplay_CircleHitsAnyBox)
+    float *minX[GRID_LAYER_COUNT];
+    float *minY[GRID_LAYER_COUNT];
+    float *maxX[GRID_LAYER_COUNT];
+    float *maxY[GRID_LAYER_COUNT];
+
+    // Allocated lengths, a rebuild that fits (editor changes) reuses the arrays
+    int cellCapacity; // Of each start[layer], in cells
+    int refCapacity[GRID_LAYER_COUNT];
+} LevelGrid;
+
+typedef struct {
+    const LevelGrid *grid;
+    GridLayer layer;
+    int cx0, cx1, cy1;
+    int cx, cy;
+    int ref, refEnd;
+} LevelGridIter;
+
+// Builds the grid from the world AABBs of every layer, growing its arrays in `arena`.
+// Items with negative width/height are skipped, so a layer can keep slots aligned
+// with another array. Cell size grows past LEVEL_GRID_CELL_SIZE on big levels.
+// Returns false if out of memory, the grid is then left empty.
+bool LevelGrid_Build(LevelGrid *grid, Arena *arena, const Rectangle *items[GRID_LAYER_COUNT], const int counts[GRID_LAYER_COUNT]);
+
+// Cell range overlapping `area` (inclusive). Returns false if it misses the grid.
+bool LevelGrid_GetCellRange(const LevelGrid *grid, Rectangle area, int *cx0, int *cy0, int *cx1, int *cy1);
+
+// Iterates item indices of `layer` in cells overlapping `area`.
+// An item spanning several cells can be returned more than once.
+LevelGridIter LevelGrid_Query(const LevelGrid *grid, GridLayer layer, Rectangle area);
+bool LevelGridIter_Next(LevelGridIter *it, int *index);
+
+#endif // LEVEL_GRID_H
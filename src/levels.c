@@ -1,50 +1,358 @@
 #include "levels.h"
+#include "nav.h"
+#include "rng.h"
+#include <stdlib.h>
+#include <string.h>
 
 // Access to episodes
-void InitEpisode1(Level *level); // Prototype from episodes/episode1.c (usually in a header)
+bool InitEpisode1(Level *level); // Prototype from episodes/episode1.c (usually in a header)
 // Actually main.c included "episodes/episodes.h". Use that.
 #include "episodes/episodes.h"
+#include "../raylib/src/raymath.h"
 
-void InitLevel(int episode, Level *level) {
+// Bakes center, axes and world AABB of a wall rotated around its center
+static WallShape BakeWallShape(Wall w) {
+  WallShape shape = {0};
+  shape.center = (Vector2){ w.rect.x + w.rect.width/2.0f, w.rect.y + w.rect.height/2.0f };
+  shape.halfExtents = (Vector2){ w.rect.width/2.0f, w.rect.height/2.0f };
+
+  float c, s;
+  float quarterTurns = w.rotation / 90.0f;
+  shape.axisAligned = (quarterTurns == floorf(quarterTurns));
+  if (shape.axisAligned) {
+    // Exact axes so the bounds are exactly the wall
+    static const float quarterCos[4] = { 1.0f, 0.0f, -1.0f, 0.0f };
+    static const float quarterSin[4] = { 0.0f, 1.0f, 0.0f, -1.0f };
+    int q = ((int)quarterTurns % 4 + 4) % 4;
+    c = quarterCos[q];
+    s = quarterSin[q];
+  } else {
+    float r = w.rotation * DEG2RAD;
+    c = cosf(r);
+    s = sinf(r);
+  }
+  shape.axisX = (Vector2){ c, s };
+  shape.axisY = (Vector2){ -s, c };
+
+  float extX = shape.halfExtents.x * fabsf(c) + shape.halfExtents.y * fabsf(s);
+  float extY = shape.halfExtents.x * fabsf(s) + shape.halfExtents.y * fabsf(c);
+  shape.bounds = (Rectangle){ shape.center.x - extX, shape.center.y - extY, extX * 2.0f, extY * 2.0f };
+  return shape;
+}
+
+// Shared by all levels so a version is never reused after a level reload
+static unsigned int staticVersionCounter = 0;
+static uint32_t enemyGenerationCounter = 0; // Shared by all slots and levels, so a generation is never reused
+
+// Capacity for `needed` entries, doubling so growing one at a time stays cheap
+static int GrownCapacity(int capacity, int needed) {
+  return (needed > capacity * 2) ? needed : capacity * 2;
+}
+
+// Grows one of the level's arrays from `capacity` to `newCapacity` entries in its arena
+static void *GrowArray(Level *level, void *items, size_t entrySize, int capacity, int newCapacity) {
+  return Arena_Realloc(&level->arena, items, entrySize * (size_t)capacity, entrySize * (size_t)newCapacity);
+}
+
+// Zeroes the entries a resize adds back after a shrink (fresh capacity already is)
+static void ClearAdded(void *items, size_t entrySize, int count, int newCount) {
+  if (newCount > count) memset((char *)items + entrySize * (size_t)count, 0, entrySize * (size_t)(newCount - count));
+}
+
+bool Level_ResizeWalls(Level *level, int count) {
+  if (count > level->wallCapacity) {
+    int capacity = GrownCapacity(level->wallCapacity, count);
+    Wall *walls = GrowArray(level, level->walls, sizeof(Wall), level->wallCapacity, capacity);
+    if (!walls) return false;
+    level->walls = walls;
+    level->wallCapacity = capacity;
+  }
+  ClearAdded(level->walls, sizeof(Wall), level->wallCount, count);
+  level->wallCount = count;
+  return true;
+}
+
+bool Level_ResizeDoors(Level *level, int count) {
+  if (count > level->doorCapacity) {
+    int capacity = GrownCapacity(level->doorCapacity, count);
+    Door *doors = GrowArray(level, level->doors, sizeof(Door), level->doorCapacity, capacity);
+    if (!doors) return false;
+    level->doors = doors;
+    unsigned int *versions = GrowArray(level, level->doorVersions, sizeof(unsigned int), level->doorCapacity, capacity);
+    if (!versions) return false;
+    level->doorVersions = versions;
+    level->doorCapacity = capacity;
+  }
+  ClearAdded(level->doors, sizeof(Door), level->doorCount, count);
+  level->doorCount = count;
+  return true;
+}
+
+bool Level_ResizeEnemies(Level *level, int count) {
+  if (count > level->enemyCapacity) {
+    int capacity = GrownCapacity(level->enemyCapacity, count);
+    EntityBody *bodies = GrowArray(level, level->enemyBodies, sizeof(EntityBody), level->enemyCapacity, capacity);
+    if (!bodies) return false;
+    level->enemyBodies = bodies;
+    EnemyAI *ai = GrowArray(level, level->enemyAI, sizeof(EnemyAI), level->enemyCapacity, capacity);
+    if (!ai) return false;
+    level->enemyAI = ai;
+    EnemyStats *stats = GrowArray(level, level->enemyStats, sizeof(EnemyStats), level->enemyCapacity, capacity);
+    if (!stats) return false;
+    level->enemyStats = stats;
+    uint32_t *generations = GrowArray(level, level->enemyGenerations, sizeof(uint32_t), level->enemyCapacity, capacity);
+    if (!generations) return false;
+    level->enemyGenerations = generations;
+    level->enemyCapacity = capacity;
+  }
+  ClearAdded(level->enemyBodies, sizeof(EntityBody), level->enemyCount, count);
+  ClearAdded(level->enemyAI, sizeof(EnemyAI), level->enemyCount, count);
+  ClearAdded(level->enemyStats, sizeof(EnemyStats), level->enemyCount, count);
+  ClearAdded(level->enemyGenerations, sizeof(uint32_t), level->enemyCount, count);
+  level->enemyCount = count;
+  return true;
+}
+
+bool Level_ResizeNpcs(Level *level, int count) {
+  if (count > level->npcCapacity) {
+    int capacity = GrownCapacity(level->npcCapacity, count);
+    NPC *npcs = GrowArray(level, level->npcs, sizeof(NPC), level->npcCapacity, capacity);
+    if (!npcs) return false;
+    level->npcs = npcs;
+    level->npcCapacity = capacity;
+  }
+  ClearAdded(level->npcs, sizeof(NPC), level->npcCount, count);
+  level->npcCount = count;
+  return true;
+}
+
+bool Level_ResizeBackgrounds(Level *level, size_t count) {
+  if (count > level->bgsCapacity) {
+    int capacity = GrownCapacity((int)level->bgsCapacity, (int)count);
+    Background *bgs = GrowArray(level, level->bgs, sizeof(Background), (int)level->bgsCapacity, capacity);
+    if (!bgs) return false;
+    level->bgs = bgs;
+    level->bgsCapacity = (size_t)capacity;
+  }
+  ClearAdded(level->bgs, sizeof(Background), (int)level->bgs_count, (int)count);
+  level->bgs_count = count;
+  return true;
+}
+
+int Level_AddWall(Level *level, Wall wall) {
+  if (!Level_ResizeWalls(level, level->wallCount + 1)) return -1;
+  level->walls[level->wallCount - 1] = wall;
+  return level->wallCount - 1;
+}
+
+int Level_AddDoor(Level *level, Door door) {
+  if (!Level_ResizeDoors(level, level->doorCount + 1)) return -1;
+  level->doors[level->doorCount - 1] = door;
+  return level->doorCount - 1;
+}
+
+int Level_AddEnemy(Level *level) {
+  if (!Level_ResizeEnemies(level, level->enemyCount + 1)) return -1;
+  return level->enemyCount - 1;
+}
+
+int Level_AddBackground(Level *level, Background background) {
+  if (!Level_ResizeBackgrounds(level, level->bgs_count + 1)) return -1;
+  level->bgs[level->bgs_count - 1] = background;
+  return (int)level->bgs_count - 1;
+}
+
+// Out of memory while building: nothing collides and nav is off until a rebuild succeeds
+static bool ClearCollision(Level *level) {
+  level->aabbWallCount = 0;
+  level->obbWallCount = 0;
+  level->grid.cols = 0;
+  level->grid.rows = 0;
+  level->staticVersion = ++staticVersionCounter;
+  Nav_Build(level);
+  return false;
+}
+
+bool Level_BuildCollision(Level *level) {
+  if (level->wallCount > level->wallShapeCapacity) {
+    int capacity = level->wallCapacity; // Grown with the walls, at least wallCount
+    WallShape *shapes = Arena_Alloc(&level->arena, sizeof(WallShape) * (size_t)capacity);
+    int *aabbWalls = Arena_Alloc(&level->arena, sizeof(int) * (size_t)capacity);
+    int *obbWalls = Arena_Alloc(&level->arena, sizeof(int) * (size_t)capacity);
+    if (!shapes || !aabbWalls || !obbWalls) {
+      TraceLog(LOG_WARNING, "Failed to allocate wall shapes for %d walls", level->wallCount);
+      return ClearCollision(level);
+    }
+    level->wallShapes = shapes;
+    level->aabbWalls = aabbWalls;
+    level->obbWalls = obbWalls;
+    level->wallShapeCapacity = capacity;
+  }
+
+  // Grid refs are wall indices, so bounds are indexed by wall (the other layer's slots stay empty).
+  // Only needed while building.
+  Rectangle *aabbBounds = malloc(sizeof(Rectangle) * (size_t)(level->wallCount * 2 + level->doorCount + 1));
+  if (!aabbBounds) {
+    TraceLog(LOG_WARNING, "Failed to allocate collision bounds for %d walls", level->wallCount);
+    return ClearCollision(level);
+  }
+  Rectangle *obbBounds = aabbBounds + level->wallCount;
+  Rectangle *doorBounds = obbBounds + level->wallCount;
+
+  level->aabbWallCount = 0;
+  level->obbWallCount = 0;
+  for (int i = 0; i < level->wallCount; i++) {
+    WallShape *shape = &level->wallShapes[i];
+    *shape = BakeWallShape(level->walls[i]);
+
+    Rectangle empty = { 0.0f, 0.0f, -1.0f, -1.0f }; // Skipped by LevelGrid_Build
+    aabbBounds[i] = shape->axisAligned ? shape->bounds : empty;
+    obbBounds[i] = shape->axisAligned ? empty : shape->bounds;
+    if (shape->axisAligned) level->aabbWalls[level->aabbWallCount++] = i;
+    else level->obbWalls[level->obbWallCount++] = i;
+  }
+  for (int i = 0; i < level->doorCount; i++) {
+    // CheckCollisionCircleRec truncates the rect center to whole pixels, pad so the grid never misses a touch
+    Rectangle r = level->doors[i].rect;
+    doorBounds[i] = (Rectangle){ r.x - 1.0f, r.y - 1.0f, r.width + 2.0f, r.height + 2.0f };
+  }
+
+  const Rectangle *items[GRID_LAYER_COUNT] = { aabbBounds, obbBounds, doorBounds };
+  const int counts[GRID_LAYER_COUNT] = { level->wallCount, level->wallCount, level->doorCount };
+  bool built = LevelGrid_Build(&level->grid, &level->arena, items, counts);
+  free(aabbBounds);
+  if (!built) return ClearCollision(level);
+  level->staticVersion = ++staticVersionCounter;
+  bool navBuilt = Nav_Build(level);
+  bool patrolBuilt = Level_BuildPatrolPoints(level);
+  return navBuilt && patrolBuilt;
+}
+
+bool Level_BuildPatrolPoints(Level *level) {
+  static const float radii[] = { 200.0f, 125.0f, 60.0f }; // Tried far to near
+  const int angles = PATROL_POINTS_PER_ENEMY;
+
+  level->patrolPointCount = 0;
+  int needed = level->enemyCount * PATROL_POINTS_PER_ENEMY;
+  if (needed > level->patrolPointCapacity) {
+    int capacity = GrownCapacity(level->patrolPointCapacity, needed);
+    Vector2 *points = Arena_Alloc(&level->arena, sizeof(Vector2) * (size_t)capacity);
+    if (!points) {
+      TraceLog(LOG_WARNING, "Failed to allocate patrol points for %d enemies", level->enemyCount);
+      for (int i = 0; i < level->enemyCount; i++) level->enemyAI[i].patrolCount = 0;
+      return false;
+    }
+    level->patrolPoints = points;
+    level->patrolPointCapacity = capacity;
+  }
+
+  for (int i = 0; i < level->enemyCount; i++) {
+    EnemyAI *enemy = &level->enemyAI[i];
+    enemy->patrolFirst = level->patrolPointCount;
+    enemy->patrolCount = 0;
+    if (enemy->aiType != AI_WALKER) continue;
+
+    // At most one point per direction, so they spread around the home position.
+    // Each enemy's ring is turned a little so neighbors don't share lines.
+    float turn = (float)i * 2.39996f; // Golden angle
+    for (int a = 0; a < angles; a++) {
+      float angle = turn + (float)a * (2.0f * PI / (float)angles);
+      Vector2 dir = { cosf(angle), sinf(angle) };
+      for (int r = 0; r < (int)(sizeof(radii) / sizeof(radii[0])); r++) {
+        Vector2 p = Vector2Add(enemy->patrolStart, Vector2Scale(dir, radii[r]));
+        if (!Nav_IsWalkableLine(level, enemy->patrolStart, p, enemy->identity.permissionLevel)) continue;
+        level->patrolPoints[level->patrolPointCount++] = p;
+        enemy->patrolCount++;
+        break;
+      }
+    }
+  }
+  return true;
+}
+
+Handle Level_EnemyHandle(const Level *level, int index) {
+  return (Handle){ (uint32_t)index, level->enemyGenerations[index] };
+}
+
+int Level_ResolveEnemy(const Level *level, Handle handle) {
+  if (handle.generation == 0 || handle.index >= (uint32_t)level->enemyCount) return -1;
+  return (level->enemyGenerations[handle.index] == handle.generation) ? (int)handle.index : -1;
+}
+
+void Level_RenewEnemyHandle(Level *level, int index) {
+  if (++enemyGenerationCounter == 0) enemyGenerationCounter = 1;
+  level->enemyGenerations[index] = enemyGenerationCounter;
+}
+
+void Level_SetDoorOpen(Level *level, int index, bool open) {
+  Door *door = &level->doors[index];
+  if (door->isOpen == open) return;
+  door->isOpen = open;
+  level->doorVersions[index]++;
+}
+
+unsigned int Level_DoorStamp(const Level *level) {
+  unsigned int stamp = 0;
+  for (int i = 0; i < level->doorCount; i++) stamp += level->doorVersions[i];
+  return stamp;
+}
+
+static void UnloadEpisode(int episode) {
+  switch (episode) {
+  case 0: UnloadProlog(); break;
+  case 1: UnloadEpisode1(); break;
+  case 2: UnloadEpisode2(); break;
+  case 3: UnloadEpisode3(); break;
+  case 4: UnloadEpisode4(); break;
+  }
+}
+
+bool InitLevel(int episode, Level *level) {
   // Unload previous episode's assets first
   static int lastEpisode = -1;
   if (lastEpisode >= 0 && lastEpisode != episode) {
-    UnloadLevel(lastEpisode);
+    UnloadEpisode(lastEpisode);
   }
   lastEpisode = episode;
 
-  // Reset entire level struct
-  *level = (Level){0};
+  UnloadLevel(level);
   level->id = episode;
+  level->seed = Rng_LevelSeed(episode);
 
+  bool loaded = true;
   switch (episode) {
   case 0:
-    InitProlog(level);
+    loaded = InitProlog(level);
     break;
   case 1:
-    InitEpisode1(level);
+    loaded = InitEpisode1(level);
     break;
   case 2:
-    InitEpisode2(level);
+    loaded = InitEpisode2(level);
     break;
   case 3:
-    InitEpisode3(level);
+    loaded = InitEpisode3(level);
     break;
   case 4:
-    InitEpisode4(level);
+    loaded = InitEpisode4(level);
     break;
   default:
     TraceLog(LOG_WARNING, "Episode %d not found!", episode);
     break;
   }
-}
+  if (!loaded) {
+    TraceLog(LOG_ERROR, "Episode %d: out of memory loading the level", episode);
+    return false;
+  }
 
-void UnloadLevel(int episode) {
-  switch (episode) {
-  case 0: UnloadProlog(); break;
-  case 1: UnloadEpisode1(); break;
-  case 2: UnloadEpisode2(); break;
-  case 3: UnloadEpisode3(); break;
-  case 4: UnloadEpisode4(); break;
+  if (!Level_BuildCollision(level)) {
+    TraceLog(LOG_ERROR, "Episode %d: out of memory building collision", episode);
+    return false;
   }
+  return true;
+}
+
+void UnloadLevel(Level *level) {
+  Arena_Free(&level->arena);
+  *level = (Level){0};
 }
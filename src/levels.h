@@ -2,9 +2,12 @@
 #define LEVELS_H
 
 #include "../raylib/src/raylib.h"
+#include "arena.h"
 #include "entity.h"
+#include "level_grid.h"
 #include "types.h"
 #include <stddef.h>
+#include <stdint.h>
 
 #define NPC_MAX_FRAMES 6
 
@@ -32,9 +35,7 @@ typedef struct NPC {
     bool dialogueCompleted;
 } NPC;
 
-#define MAX_WALLS 200
-#define MAX_DOORS 20
-#define MAX_ENEMIES 50
+#define PATROL_POINTS_PER_ENEMY 8
 
 typedef struct {
 	Texture2D texture;
@@ -47,6 +48,17 @@ typedef struct {
     float rotation; // Degrees
 } Wall;
 
+// Baked collision record of a Wall, built by Level_BuildCollision.
+// Hot collision/ray code reads this instead of rect + rotation, so no trig runs per query.
+typedef struct {
+    Vector2 center;
+    Vector2 halfExtents;
+    Vector2 axisX;    // Wall's local +X in world space (unit)
+    Vector2 axisY;    // Wall's local +Y in world space (unit)
+    Rectangle bounds; // World AABB of the rotated rect (the wall itself if axisAligned)
+    bool axisAligned; // Rotation is a multiple of 90 degrees
+} WallShape;
+
 typedef struct {
     Rectangle rect;
     PermissionLevel requiredPerm;
@@ -54,24 +66,59 @@ typedef struct {
     float animationProgress; // 0.0 = Closed, 1.0 = Fully Open
 } Door;
 
+// Arrays of a Level point into its arena, `capacity` entries of which `count` are in use.
+// Episodes size them with the Level_Resize* functions (or grow them one at a time with
+// Level_Add*); everything is freed at once by UnloadLevel.
 typedef struct {
   int id; // Phase/Episode ID
+  uint64_t seed; // Root of the level's random streams (see rng.h)
+  Arena arena;
 
   // Level Layout
-  Wall walls[MAX_WALLS];
+  Wall *walls;
   int wallCount;
+  int wallCapacity;
+  WallShape *wallShapes; // Baked from walls, see Level_BuildCollision
+
+  // Wall indices split by shape at load: plain boxes vs rotated OBBs
+  int *aabbWalls;
+  int aabbWallCount;
+  int *obbWalls;
+  int obbWallCount;
+  int wallShapeCapacity; // Of wallShapes, aabbWalls and obbWalls
 
   // Interactive Objects
-  Door doors[MAX_DOORS];
+  Door *doors;
   int doorCount;
+  int doorCapacity; // Also of doorVersions
 
-  // NPCs
-  Entity enemies[MAX_ENEMIES];
+  // NPCs, by component (see EntityBody). Hot loops only walk enemyBodies.
+  EntityBody *enemyBodies;
+  EnemyAI *enemyAI;
+  EnemyStats *enemyStats;
+  uint32_t *enemyGenerations; // See Level_EnemyHandle
   int enemyCount;
+  int enemyCapacity;
+
+  // Walker patrol waypoints, each enemy owns a run of them (see Level_BuildPatrolPoints)
+  Vector2 *patrolPoints;
+  int patrolPointCount;
+  int patrolPointCapacity;
+
+  // Broadphase over walls/doors (see Level_BuildCollision)
+  LevelGrid grid;
+
+  // Change counters for caches of sight/paths. Walls are static: staticVersion only
+  // changes when collision is rebuilt (level load, editor). Doors are the dynamic
+  // occluders: doorVersions[i] changes when door i opens or closes, so a cache only
+  // needs to watch the doors it actually depends on.
+  unsigned int staticVersion;
+  unsigned int *doorVersions;
 
   // NPCs (non-hostile, interactable)
+  NPC *npcs;
   int npcCount;
-  NPC npcs[8];
+  int npcCapacity;
 
   // Spawn Point
   Vector2 playerSpawn;
@@ -79,8 +126,9 @@ typedef struct {
 
   Rectangle win_area;
 
-  Background bgs[MAX_DOORS];
+  Background *bgs;
   size_t bgs_count;
+  size_t bgsCapacity;
 
   // Dialogue UI state (simple, one-line)
   const char *activeDialogueText;
@@ -104,8 +152,54 @@ typedef struct {
 
 } Level;
 
-// Function prototype for level loader
-void InitLevel(int episode, Level *level);
-void UnloadLevel(int episode);
+// Function prototype for level loader. Returns false if the level could not be
+// built (out of memory), it is then incomplete and should not be played.
+bool InitLevel(int episode, Level *level);
+
+// Frees the level's contents (its arena) and empties it. The episode's assets stay
+// loaded until another episode is initialized.
+void UnloadLevel(Level *level);
+
+// Set the number of walls/doors/enemies/NPCs/backgrounds, growing the arrays in the
+// level's arena as needed (new entries zeroed). False if out of memory (nothing changes).
+bool Level_ResizeWalls(Level *level, int count);
+bool Level_ResizeDoors(Level *level, int count);
+bool Level_ResizeEnemies(Level *level, int count);
+bool Level_ResizeNpcs(Level *level, int count);
+bool Level_ResizeBackgrounds(Level *level, size_t count);
+
+// Append one entry, return its index (-1 where Level_Resize* would fail).
+// A new enemy is zeroed, fill it with InitEnemy.
+int Level_AddWall(Level *level, Wall wall);
+int Level_AddDoor(Level *level, Door door);
+int Level_AddEnemy(Level *level);
+int Level_AddBackground(Level *level, Background background);
+
+// Rebuilds collision acceleration data (wall shapes, grid, nav grid, patrol points) from walls/doors.
+// Called by InitLevel; call again whenever level geometry is edited. Returns false if out
+// of memory: walls and doors are kept, but nothing collides with them until a rebuild succeeds.
+bool Level_BuildCollision(Level *level);
+
+// Picks up to PATROL_POINTS_PER_ENEMY waypoints around each walker's patrolStart that it can
+// walk to in a straight line (clear of walls, through doors it may pass). Called by
+// Level_BuildCollision; call again after adding enemies. False if out of memory (no
+// walker has patrol points then).
+bool Level_BuildPatrolPoints(Level *level);
+
+// Handle to enemy `index`. It stays valid while that enemy keeps its slot (dead or
+// alive); replacing or moving the enemy (InitEnemy, the editor) makes it stale.
+Handle Level_EnemyHandle(const Level *level, int index);
+
+// Index of the enemy `handle` refers to, -1 if stale
+int Level_ResolveEnemy(const Level *level, Handle handle);
+
+// Gives enemy slot `index` a new generation, call when what is stored there changes
+void Level_RenewEnemyHandle(Level *level, int index);
+
+// Opens/closes a door, bumping its doorVersions entry if its state changes
+void Level_SetDoorOpen(Level *level, int index, bool open);
+
+// Sum of the door versions: changes whenever any door opens or closes
+unsigned int Level_DoorStamp(const Level *level);
 
 #endif // LEVELS_H
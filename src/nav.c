@@ -0,0 +1,1201 @@
+#include "nav.h"
+#include "../raylib/src/raymath.h"
+#include <float.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NAV_NO_DOOR (-1)
+#define NAV_QUEUE_INITIAL_CAPACITY 64
+#define NAV_HEAP_CLOSED (-1)
+#define NAV_SMOOTH_LOOKAHEAD 32 // Cells a path waypoint may skip ahead, bounds the smoothing cost
+#define NAV_FLOW_MAX_DOORS 32   // Doors a flow window keeps versions of, with more it checks Level_DoorStamp
+
+typedef struct {
+    Vector2 origin;
+    float cellSize;
+    float clearance; // Agent radius plus half a cell diagonal
+    int cols;
+    int rows;
+    unsigned char blocked[NAV_MAX_CELLS]; // Too close to a wall
+    int door[NAV_MAX_CELLS];              // Door the cell overlaps, or NAV_NO_DOOR
+    int room[NAV_MAX_CELLS];              // Room of a walkable cell outside doors, or -1
+} NavGrid;
+
+// Indexed binary min-heap of cells, ordered by key[cell]
+typedef struct {
+    int *items;
+    int *pos; // Index of each cell in items, or NAV_HEAP_CLOSED once popped
+    const float *key;
+    int count;
+} NavHeap;
+
+typedef struct {
+    int startCell; // Cell the cached search started from
+    NavPath path;
+} NavCacheEntry;
+
+static NavGrid grid;
+
+// 8-neighborhood: the 4 sides first, then the diagonals
+static const int neighborX[8] = { 1, -1, 0, 0, 1, 1, -1, -1 };
+static const int neighborY[8] = { 0, 0, 1, -1, 1, -1, 1, -1 };
+static const float neighborCost[8] = { 1.0f, 1.0f, 1.0f, 1.0f, 1.41421356f, 1.41421356f, 1.41421356f, 1.41421356f };
+
+// A* scratch. Cells are (re)initialized lazily when visitStamp != searchStamp,
+// so nothing has to be cleared between searches.
+static unsigned int visitStamp[NAV_MAX_CELLS];
+static unsigned int searchStamp;
+static float gCost[NAV_MAX_CELLS];
+static float fCost[NAV_MAX_CELLS];
+static int parent[NAV_MAX_CELLS];
+static int openItems[NAV_MAX_CELLS];
+static int openPos[NAV_MAX_CELLS];
+static NavHeap openSet = { openItems, openPos, fCost, 0 };
+static int pathCells[NAV_MAX_CELLS];
+
+// Portal graph: rooms (connected walkable cells between doors) linked by the doors they touch
+static int roomCount;
+static bool roomsValid; // False when the level has more than NAV_MAX_ROOMS rooms, searches then run unguided
+static int roomDoorStart[NAV_MAX_ROOMS + 1]; // Room r touches roomDoors[roomDoorStart[r] .. roomDoorStart[r + 1])
+// Door tables are sized to the level's doors by Nav_Build (doorCapacity of each)
+static int doorCapacity;
+static int *roomDoors; // NAV_MAX_DOOR_ROOMS per door
+static int *doorGroup; // Doors whose cells touch (double doors) act as one, led by doorGroup[d]
+static int *doorRoomCount; // Only the group leader has rooms
+static int (*doorRooms)[NAV_MAX_DOOR_ROOMS];
+static Vector2 *doorCenters;
+
+// Route planning scratch. A route's rooms and doors are marked with corridorStamp,
+// the cell search that follows only enters those.
+static float routeCost[NAV_MAX_ROOMS];
+static Vector2 routeEntry[NAV_MAX_ROOMS]; // Where the route enters the room
+static int routeParent[NAV_MAX_ROOMS];
+static int routeVia[NAV_MAX_ROOMS];       // Door it enters through
+static int routeItems[NAV_MAX_ROOMS];
+static int routePos[NAV_MAX_ROOMS];
+static unsigned int corridorStamp;
+static unsigned int roomCorridor[NAV_MAX_ROOMS];
+static unsigned int *doorCorridor;
+
+// Last sound spread over the rooms (see Nav_SpreadSound)
+static bool soundValid;
+static float soundCost[NAV_MAX_ROOMS];     // Distance traveled to enter the room, FLT_MAX if not reached
+static Vector2 soundEntry[NAV_MAX_ROOMS];  // Where it entered
+
+// Search in progress (path == NULL when idle), resumed by Nav_Update across frames
+static struct {
+    NavPath *path;
+    int startCell;
+    int goalCell;
+    unsigned int request; // path->request it was started for, a newer request drops it
+    PermissionLevel permission;
+    int expansions;
+    bool inCorridor; // Limited to the rooms of its route, see PlanRoute
+    int blockerCount; // Door groups that stopped it so far, -1 if too many (see NoteBlocker)
+    int blockers[NAV_MAX_PATH_DOORS];
+} search;
+
+static NavPath **queue; // Ring of queueCapacity, grown when full
+static int queueCapacity;
+static int queueHead;
+static int queueCount;
+
+static NavCacheEntry cache[NAV_CACHE_SIZE];
+static int cacheCount;
+static int cacheNext; // Ring slot replaced next
+
+// Flow field: cost to the target from every cell of a window around it
+typedef struct {
+    int x0, y0, cols, rows; // Window in grid cells
+    int targetCell;
+    unsigned int staticVersion;
+    int doorCount;                                  // Doors in the window that can stop its permission, -1 if too many
+    int doors[NAV_FLOW_MAX_DOORS];
+    unsigned int doorVersions[NAV_FLOW_MAX_DOORS]; // Their versions when built
+    unsigned int doorStamp;                        // Level_DoorStamp when built, checked instead if doorCount is -1
+    float cost[NAV_FLOW_CELLS]; // FLT_MAX where the target can't be reached
+} NavFlowWindow;
+
+// One field per permission level, rebuilt while agents sample it
+typedef struct {
+    bool ready;
+    NavFlowWindow front;      // Sampled by Nav_SampleFlow
+    Vector2 wantedTarget;
+    unsigned int wantedFrame; // Last frame it was sampled
+} NavFlowField;
+
+static NavFlowField flowFields[NAV_FLOW_FIELDS];
+static unsigned int navFrame;
+
+// Field being rebuilt (field == -1 when idle): a Dijkstra over the back window, resumed across frames
+static struct {
+    int field;
+    NavFlowWindow back;
+    int items[NAV_FLOW_CELLS];
+    int pos[NAV_FLOW_CELLS];
+    NavHeap heap;
+} flowBuild = { .field = -1 };
+
+static int ClampInt(int v, int lo, int hi) {
+    if (v < lo) return lo;
+    if (v > hi) return hi;
+    return v;
+}
+
+static int CellOf(Vector2 p) {
+    float inv = 1.0f / grid.cellSize;
+    int cx = ClampInt((int)floorf((p.x - grid.origin.x) * inv), 0, grid.cols - 1);
+    int cy = ClampInt((int)floorf((p.y - grid.origin.y) * inv), 0, grid.rows - 1);
+    return cy * grid.cols + cx;
+}
+
+static Vector2 CellCenter(int cell) {
+    return (Vector2){
+        grid.origin.x + ((float)(cell % grid.cols) + 0.5f) * grid.cellSize,
+        grid.origin.y + ((float)(cell / grid.cols) + 0.5f) * grid.cellSize
+    };
+}
+
+// Same rule as enemy movement: a closed door only stops agents below its permission
+static bool IsDoorPassable(const Level *level, int door, PermissionLevel permission) {
+    return level->doors[door].isOpen || permission >= level->doors[door].requiredPerm;
+}
+
+// A door group can be crossed if any of its doors can
+static bool IsGroupPassable(const Level *level, int leader, PermissionLevel permission) {
+    for (int d = 0; d < level->doorCount; d++) {
+        if (doorGroup[d] == leader && IsDoorPassable(level, d, permission)) return true;
+    }
+    return false;
+}
+
+static bool IsPassable(const Level *level, int cell, PermissionLevel permission) {
+    if (grid.blocked[cell]) return false;
+    int d = grid.door[cell];
+    return d == NAV_NO_DOOR || IsDoorPassable(level, d, permission);
+}
+
+static bool IsGroupOpen(const Level *level, int leader) {
+    for (int d = 0; d < level->doorCount; d++) {
+        if (doorGroup[d] == leader && level->doors[d].isOpen) return true;
+    }
+    return false;
+}
+
+// A failed path is worth searching again once a door group that stopped it can be passed
+static bool BlockersPassable(const NavPath *path, const Level *level) {
+    if (path->doorCount < 0) return path->doorStamp != Level_DoorStamp(level);
+    for (int i = 0; i < path->doorCount; i++) {
+        if (IsGroupPassable(level, path->doors[i], path->permission)) return true;
+    }
+    return false;
+}
+
+static bool DoorsPassable(const NavPath *path, const Level *level) {
+    for (int i = 0; i < path->doorCount; i++) {
+        const Door *door = &level->doors[path->doors[i]];
+        if (!door->isOpen && path->permission < door->requiredPerm) return false;
+    }
+    return true;
+}
+
+// Marks cells whose center is closer than the clearance to the box (center, axes, half extents)
+static void RasterizeBox(Vector2 center, Vector2 axisX, Vector2 axisY, Vector2 half, Rectangle bounds, int door) {
+    float c = grid.clearance;
+    float inv = 1.0f / grid.cellSize;
+    int x0 = ClampInt((int)floorf((bounds.x - c - grid.origin.x) * inv), 0, grid.cols - 1);
+    int y0 = ClampInt((int)floorf((bounds.y - c - grid.origin.y) * inv), 0, grid.rows - 1);
+    int x1 = ClampInt((int)floorf((bounds.x + bounds.width + c - grid.origin.x) * inv), 0, grid.cols - 1);
+    int y1 = ClampInt((int)floorf((bounds.y + bounds.height + c - grid.origin.y) * inv), 0, grid.rows - 1);
+
+    for (int cy = y0; cy <= y1; cy++) {
+        for (int cx = x0; cx <= x1; cx++) {
+            int cell = cy * grid.cols + cx;
+            Vector2 d = Vector2Subtract(CellCenter(cell), center);
+            float dx = fmaxf(fabsf(Vector2DotProduct(d, axisX)) - half.x, 0.0f);
+            float dy = fmaxf(fabsf(Vector2DotProduct(d, axisY)) - half.y, 0.0f);
+            if (dx * dx + dy * dy >= c * c) continue;
+
+            if (door == NAV_NO_DOOR) grid.blocked[cell] = 1;
+            else grid.door[cell] = door;
+        }
+    }
+}
+
+// Flood-fills rooms over the walkable cells outside doors, then links each door to the rooms next to it
+static void BuildRooms(const Level *level) {
+    int cellCount = grid.cols * grid.rows;
+    roomCount = 0;
+    roomsValid = true;
+    for (int c = 0; c < cellCount; c++) grid.room[c] = -1;
+    for (int d = 0; d < level->doorCount; d++) {
+        Rectangle r = level->doors[d].rect;
+        doorCenters[d] = (Vector2){ r.x + r.width / 2.0f, r.y + r.height / 2.0f };
+        doorRoomCount[d] = 0;
+        doorGroup[d] = d;
+    }
+
+    // Group doors with touching cells, the lowest index leads
+    for (int c = 0; c < cellCount; c++) {
+        int d = grid.door[c];
+        if (d == NAV_NO_DOOR || grid.blocked[c]) continue;
+        int cx = c % grid.cols;
+        int cy = c / grid.cols;
+        int right = (cx + 1 < grid.cols) ? grid.door[c + 1] : NAV_NO_DOOR;
+        int down = (cy + 1 < grid.rows) ? grid.door[c + grid.cols] : NAV_NO_DOOR;
+        int touching[2] = { right, down };
+        for (int k = 0; k < 2; k++) {
+            int e = touching[k];
+            if (e == NAV_NO_DOOR || doorGroup[e] == doorGroup[d]) continue;
+            int keep = (doorGroup[d] < doorGroup[e]) ? doorGroup[d] : doorGroup[e];
+            int drop = (doorGroup[d] < doorGroup[e]) ? doorGroup[e] : doorGroup[d];
+            for (int i = 0; i < level->doorCount; i++) {
+                if (doorGroup[i] == drop) doorGroup[i] = keep;
+            }
+        }
+    }
+
+    // 4-connected, same as the cell search (it never cuts corners)
+    int *stack = pathCells;
+    for (int c = 0; c < cellCount; c++) {
+        if (grid.blocked[c] || grid.door[c] != NAV_NO_DOOR || grid.room[c] >= 0) continue;
+        if (roomCount == NAV_MAX_ROOMS) {
+            roomsValid = false;
+            return;
+        }
+        int room = roomCount++;
+        int top = 0;
+        grid.room[c] = room;
+        stack[top++] = c;
+        while (top > 0) {
+            int cell = stack[--top];
+            int cx = cell % grid.cols;
+            int cy = cell / grid.cols;
+            for (int k = 0; k < 4; k++) {
+                int x = cx + neighborX[k];
+                int y = cy + neighborY[k];
+                if (x < 0 || y < 0 || x >= grid.cols || y >= grid.rows) continue;
+                int n = y * grid.cols + x;
+                if (grid.blocked[n] || grid.room[n] >= 0) continue;
+
+                if (grid.door[n] == NAV_NO_DOOR) {
+                    grid.room[n] = room;
+                    stack[top++] = n;
+                    continue;
+                }
+                // Door cell on the room's border: link its group once
+                int d = doorGroup[grid.door[n]];
+                bool linked = false;
+                for (int i = 0; i < doorRoomCount[d]; i++) linked |= (doorRooms[d][i] == room);
+                if (!linked && doorRoomCount[d] < NAV_MAX_DOOR_ROOMS) doorRooms[d][doorRoomCount[d]++] = room;
+            }
+        }
+    }
+
+    // Room -> doors, counting sort like the level grid
+    for (int r = 0; r <= roomCount; r++) roomDoorStart[r] = 0;
+    for (int d = 0; d < level->doorCount; d++) {
+        for (int i = 0; i < doorRoomCount[d]; i++) roomDoorStart[doorRooms[d][i] + 1]++;
+    }
+    for (int r = 0; r < roomCount; r++) roomDoorStart[r + 1] += roomDoorStart[r];
+    for (int d = 0; d < level->doorCount; d++) {
+        for (int i = 0; i < doorRoomCount[d]; i++) roomDoors[roomDoorStart[doorRooms[d][i]]++] = d;
+    }
+    for (int r = roomCount; r > 0; r--) roomDoorStart[r] = roomDoorStart[r - 1];
+    roomDoorStart[0] = 0;
+}
+
+// Grows one door table to `capacity` entries of `entrySize`, false if out of memory
+static bool GrowDoorTable(void **table, size_t entrySize, int capacity) {
+    void *grown = realloc(*table, entrySize * (size_t)capacity);
+    if (!grown) return false;
+    *table = grown;
+    return true;
+}
+
+static bool ReserveDoors(int doorCount) {
+    if (doorCount <= doorCapacity) return true;
+    int capacity = (doorCount > doorCapacity * 2) ? doorCount : doorCapacity * 2;
+    if (!GrowDoorTable((void **)&roomDoors, sizeof(int) * NAV_MAX_DOOR_ROOMS, capacity) ||
+        !GrowDoorTable((void **)&doorGroup, sizeof(int), capacity) ||
+        !GrowDoorTable((void **)&doorRoomCount, sizeof(int), capacity) ||
+        !GrowDoorTable((void **)&doorRooms, sizeof(doorRooms[0]), capacity) ||
+        !GrowDoorTable((void **)&doorCenters, sizeof(Vector2), capacity) ||
+        !GrowDoorTable((void **)&doorCorridor, sizeof(unsigned int), capacity)) {
+        TraceLog(LOG_WARNING, "Failed to allocate navigation tables for %d doors", doorCount);
+        return false;
+    }
+    // New corridor stamps must not match a current one
+    for (int d = doorCapacity; d < capacity; d++) doorCorridor[d] = 0;
+    doorCapacity = capacity;
+    return true;
+}
+
+bool Nav_Build(const Level *level) {
+    search.path = NULL;
+    soundValid = false;
+    queueHead = 0;
+    queueCount = 0;
+    cacheCount = 0;
+    cacheNext = 0;
+    flowBuild.field = -1;
+    for (int i = 0; i < NAV_FLOW_FIELDS; i++) flowFields[i].ready = false;
+
+    // Cover the collision grid plus a margin, so agents touching the outer walls still have cells
+    const LevelGrid *lg = &level->grid;
+    grid.cols = 0;
+    grid.rows = 0;
+    if (lg->cols <= 0 || lg->rows <= 0) return true;
+    if (!ReserveDoors(level->doorCount)) return false;
+
+    float margin = NAV_CELL_SIZE * 2.0f;
+    float width = lg->cols * lg->cellSize + margin * 2.0f;
+    float height = lg->rows * lg->cellSize + margin * 2.0f;
+    grid.origin = (Vector2){ lg->origin.x - margin, lg->origin.y - margin };
+    grid.cellSize = NAV_CELL_SIZE;
+    for (;;) {
+        grid.cols = (int)ceilf(width / grid.cellSize);
+        grid.rows = (int)ceilf(height / grid.cellSize);
+        if (grid.cols * grid.rows <= NAV_MAX_CELLS) break;
+        grid.cellSize *= 2.0f;
+    }
+    grid.clearance = NAV_AGENT_RADIUS + grid.cellSize * 0.70710678f;
+
+    int cellCount = grid.cols * grid.rows;
+    memset(grid.blocked, 0, (size_t)cellCount);
+    for (int c = 0; c < cellCount; c++) grid.door[c] = NAV_NO_DOOR;
+
+    for (int i = 0; i < level->doorCount; i++) {
+        Rectangle r = level->doors[i].rect;
+        Vector2 half = { r.width / 2.0f, r.height / 2.0f };
+        Vector2 center = { r.x + half.x, r.y + half.y };
+        RasterizeBox(center, (Vector2){ 1.0f, 0.0f }, (Vector2){ 0.0f, 1.0f }, half, r, i);
+    }
+    // Walls last: a cell next to both a wall and a door is blocked
+    for (int i = 0; i < level->wallCount; i++) {
+        const WallShape *s = &level->wallShapes[i];
+        RasterizeBox(s->center, s->axisX, s->axisY, s->halfExtents, s->bounds, NAV_NO_DOOR);
+    }
+
+    BuildRooms(level);
+    return true;
+}
+
+bool Nav_IsWalkableLine(const Level *level, Vector2 a, Vector2 b, PermissionLevel permission) {
+    if (grid.cols <= 0) return false;
+
+    int cell = CellOf(a);
+    int endCell = CellOf(b);
+    int cx = cell % grid.cols;
+    int cy = cell / grid.cols;
+    int endX = endCell % grid.cols;
+    int endY = endCell / grid.cols;
+
+    // Grid DDA from a to b, every crossed cell must be passable. It takes exactly one
+    // step per cell boundary crossed, so the step count bounds the walk.
+    Vector2 delta = Vector2Subtract(b, a);
+    int stepX = (endX > cx) ? 1 : -1;
+    int stepY = (endY > cy) ? 1 : -1;
+    float invX = (delta.x != 0.0f) ? 1.0f / fabsf(delta.x) : FLT_MAX;
+    float invY = (delta.y != 0.0f) ? 1.0f / fabsf(delta.y) : FLT_MAX;
+    float cs = grid.cellSize;
+    float tNextX = (delta.x != 0.0f) ? fabsf(grid.origin.x + (cx + (stepX > 0)) * cs - a.x) * invX : FLT_MAX;
+    float tNextY = (delta.y != 0.0f) ? fabsf(grid.origin.y + (cy + (stepY > 0)) * cs - a.y) * invY : FLT_MAX;
+    float tStepX = cs * invX;
+    float tStepY = cs * invY;
+
+    int stepsX = abs(endX - cx);
+    int stepsY = abs(endY - cy);
+    for (;;) {
+        if (!IsPassable(level, cy * grid.cols + cx, permission)) return false;
+        if (stepsX == 0 && stepsY == 0) return true;
+
+        if (stepsY == 0 || (stepsX > 0 && tNextX < tNextY)) {
+            cx += stepX;
+            tNextX += tStepX;
+            stepsX--;
+        } else {
+            cy += stepY;
+            tNextY += tStepY;
+            stepsY--;
+        }
+    }
+}
+
+// Closest passable cell within a few cells of `cell` (agents hugging a wall, goals inside one), or -1
+static int NearestPassable(const Level *level, int cell, PermissionLevel permission) {
+    if (IsPassable(level, cell, permission)) return cell;
+
+    int cx = cell % grid.cols;
+    int cy = cell / grid.cols;
+    for (int r = 1; r <= 3; r++) {
+        int best = -1;
+        int bestDist = 0;
+        for (int y = cy - r; y <= cy + r; y++) {
+            for (int x = cx - r; x <= cx + r; x++) {
+                if (x < 0 || y < 0 || x >= grid.cols || y >= grid.rows) continue;
+                if (abs(x - cx) != r && abs(y - cy) != r) continue; // Ring only
+                int c = y * grid.cols + x;
+                int d = (x - cx) * (x - cx) + (y - cy) * (y - cy);
+                if ((best < 0 || d < bestDist) && IsPassable(level, c, permission)) {
+                    best = c;
+                    bestDist = d;
+                }
+            }
+        }
+        if (best >= 0) return best;
+    }
+    return -1;
+}
+
+static float Heuristic(int a, int b) {
+    // Octile distance in cells
+    float dx = fabsf((float)(a % grid.cols - b % grid.cols));
+    float dy = fabsf((float)(a / grid.cols - b / grid.cols));
+    return fmaxf(dx, dy) + (1.41421356f - 1.0f) * fminf(dx, dy);
+}
+
+static void HeapSwap(NavHeap *h, int i, int j) {
+    int a = h->items[i];
+    h->items[i] = h->items[j];
+    h->items[j] = a;
+    h->pos[h->items[i]] = i;
+    h->pos[h->items[j]] = j;
+}
+
+// Moves items[i] up after its key decreased
+static void HeapUp(NavHeap *h, int i) {
+    while (i > 0) {
+        int p = (i - 1) / 2;
+        if (h->key[h->items[p]] <= h->key[h->items[i]]) break;
+        HeapSwap(h, i, p);
+        i = p;
+    }
+}
+
+static void HeapDown(NavHeap *h, int i) {
+    for (;;) {
+        int l = i * 2 + 1;
+        int r = l + 1;
+        int m = i;
+        if (l < h->count && h->key[h->items[l]] < h->key[h->items[m]]) m = l;
+        if (r < h->count && h->key[h->items[r]] < h->key[h->items[m]]) m = r;
+        if (m == i) break;
+        HeapSwap(h, i, m);
+        i = m;
+    }
+}
+
+static void HeapPush(NavHeap *h, int cell) {
+    h->items[h->count] = cell;
+    h->pos[cell] = h->count;
+    HeapUp(h, h->count++);
+}
+
+static int HeapPop(NavHeap *h) {
+    int top = h->items[0];
+    h->count--;
+    if (h->count > 0) {
+        h->items[0] = h->items[h->count];
+        h->pos[h->items[0]] = 0;
+        HeapDown(h, 0);
+    }
+    h->pos[top] = NAV_HEAP_CLOSED;
+    return top;
+}
+
+// Opens `cell` with cost g, or lowers its cost if already open. Closed cells are final.
+static void Relax(int cell, int from, float g) {
+    if (visitStamp[cell] != searchStamp) {
+        visitStamp[cell] = searchStamp;
+        gCost[cell] = g;
+        fCost[cell] = g + Heuristic(cell, search.goalCell);
+        parent[cell] = from;
+        HeapPush(&openSet, cell);
+        return;
+    }
+    if (openSet.pos[cell] == NAV_HEAP_CLOSED || g >= gCost[cell]) return;
+    fCost[cell] -= gCost[cell] - g;
+    gCost[cell] = g;
+    parent[cell] = from;
+    HeapUp(&openSet, openSet.pos[cell]);
+}
+
+// Rooms a cell belongs to: its own, or all rooms next to it for a door cell. Returns the count.
+static int CellRooms(int cell, int *rooms) {
+    if (grid.room[cell] >= 0) {
+        rooms[0] = grid.room[cell];
+        return 1;
+    }
+    if (grid.door[cell] == NAV_NO_DOOR) return 0;
+    int d = doorGroup[grid.door[cell]];
+    for (int i = 0; i < doorRoomCount[d]; i++) rooms[i] = doorRooms[d][i];
+    return doorRoomCount[d];
+}
+
+// Dijkstra over the portal graph from the room(s) of startCell to those of goalCell, through
+// doors `permission` can pass. A room's cost is measured from the point the route enters it.
+// On success marks the route's rooms and doors with a new corridorStamp, writes up to maxDoors
+// doors in route order and returns the route's door count; returns -1 if there is no route.
+static int PlanRoute(const Level *level, int startCell, Vector2 startPos, int goalCell,
+                     PermissionLevel permission, int *doors, int maxDoors) {
+    int startRooms[NAV_MAX_DOOR_ROOMS];
+    int goalRooms[NAV_MAX_DOOR_ROOMS];
+    int startCount = CellRooms(startCell, startRooms);
+    int goalCount = CellRooms(goalCell, goalRooms);
+    if (startCount == 0 || goalCount == 0) return -1;
+
+    for (int r = 0; r < roomCount; r++) routeCost[r] = FLT_MAX;
+    NavHeap heap = { routeItems, routePos, routeCost, 0 };
+    for (int i = 0; i < startCount; i++) {
+        int r = startRooms[i];
+        routeCost[r] = 0.0f;
+        routeEntry[r] = startPos;
+        routeParent[r] = -1;
+        routeVia[r] = -1;
+        HeapPush(&heap, r);
+    }
+
+    int end = -1;
+    while (heap.count > 0 && end < 0) {
+        int r = HeapPop(&heap);
+        for (int i = 0; i < goalCount; i++) {
+            if (goalRooms[i] == r) end = r;
+        }
+        if (end >= 0) break;
+
+        for (int i = roomDoorStart[r]; i < roomDoorStart[r + 1]; i++) {
+            int d = roomDoors[i];
+            if (!IsGroupPassable(level, d, permission)) continue;
+            float cost = routeCost[r] + Vector2Distance(routeEntry[r], doorCenters[d]);
+            for (int k = 0; k < doorRoomCount[d]; k++) {
+                int next = doorRooms[d][k];
+                if (next == r || cost >= routeCost[next]) continue;
+                bool queued = (routeCost[next] != FLT_MAX);
+                if (queued && heap.pos[next] == NAV_HEAP_CLOSED) continue;
+                routeCost[next] = cost;
+                routeEntry[next] = doorCenters[d];
+                routeParent[next] = r;
+                routeVia[next] = d;
+                if (queued) HeapUp(&heap, heap.pos[next]);
+                else HeapPush(&heap, next);
+            }
+        }
+    }
+    if (end < 0) return -1;
+
+    corridorStamp++;
+    int count = 0;
+    for (int r = end; r >= 0; r = routeParent[r]) {
+        roomCorridor[r] = corridorStamp;
+        if (routeVia[r] >= 0) {
+            doorCorridor[routeVia[r]] = corridorStamp;
+            count++;
+        }
+    }
+    // Doors are found goal -> start, write them the other way round
+    int i = count;
+    for (int r = end; r >= 0; r = routeParent[r]) {
+        if (routeVia[r] < 0) continue;
+        i--;
+        if (i < maxDoors) doors[i] = routeVia[r];
+    }
+    // Start or goal standing in a doorway
+    if (grid.door[startCell] != NAV_NO_DOOR) doorCorridor[doorGroup[grid.door[startCell]]] = corridorStamp;
+    if (grid.door[goalCell] != NAV_NO_DOOR) doorCorridor[doorGroup[grid.door[goalCell]]] = corridorStamp;
+    return count;
+}
+
+static bool InCorridor(int cell) {
+    if (grid.room[cell] >= 0) return roomCorridor[grid.room[cell]] == corridorStamp;
+    int d = grid.door[cell];
+    return d != NAV_NO_DOOR && doorCorridor[doorGroup[d]] == corridorStamp;
+}
+
+static void CacheStore(const NavPath *path, int startCell) {
+    NavCacheEntry *entry = &cache[cacheNext];
+    entry->startCell = startCell;
+    entry->path = *path;
+    cacheNext = (cacheNext + 1) % NAV_CACHE_SIZE;
+    if (cacheCount < NAV_CACHE_SIZE) cacheCount++;
+}
+
+// A cached path to the same goal cell that starts next to the agent and is reachable in a straight line
+static const NavPath *CacheLookup(const NavPath *path, const Level *level) {
+    int startCell = CellOf(path->start);
+    int sx = startCell % grid.cols;
+    int sy = startCell / grid.cols;
+    for (int i = 0; i < cacheCount; i++) {
+        const NavCacheEntry *entry = &cache[i];
+        const NavPath *p = &entry->path;
+        if (p->goalCell != path->goalCell || p->permission != path->permission) continue;
+        if (abs(entry->startCell % grid.cols - sx) > 2 || abs(entry->startCell / grid.cols - sy) > 2) continue;
+        if (!DoorsPassable(p, level)) continue;
+        if (!Nav_IsWalkableLine(level, path->start, p->points[0], path->permission)) continue;
+        return p;
+    }
+    return NULL;
+}
+
+// Turns the found cell chain into waypoints: each waypoint is the farthest cell still
+// reachable in a straight line from the previous one
+static void FinishPath(const Level *level, NavPath *path, int endCell) {
+    int n = 0;
+    for (int c = endCell; c != -1; c = parent[c]) pathCells[n++] = c;
+    // pathCells runs goal -> start
+
+    // Doors from the start on. A path through more doors than it can hold ends before
+    // the first one it can't, and is searched again from there.
+    bool cut = false;
+    path->doorCount = 0;
+    for (int i = n - 1; i >= 0; i--) {
+        int d = grid.door[pathCells[i]];
+        if (d == NAV_NO_DOOR) continue;
+        bool seen = false;
+        for (int k = 0; k < path->doorCount; k++) seen |= (path->doors[k] == d);
+        if (seen) continue;
+        if (path->doorCount == NAV_MAX_PATH_DOORS) {
+            n -= i + 1; // The start cell has no new door, so at least it is left
+            memmove(pathCells, &pathCells[i + 1], sizeof(pathCells[0]) * (size_t)n);
+            endCell = pathCells[0];
+            cut = true;
+            break;
+        }
+        path->doors[path->doorCount++] = d;
+    }
+
+    // Exact goal as the last point when it is itself reachable
+    Vector2 end = (endCell == path->goalCell) ? path->goal : CellCenter(endCell);
+
+    path->pointCount = 0;
+    path->next = 0;
+    path->truncated = cut;
+    Vector2 from = path->start;
+    int i = n - 1;
+    while (i > 0) {
+        int j = i - 1;
+        int jMin = (i > NAV_SMOOTH_LOOKAHEAD) ? i - NAV_SMOOTH_LOOKAHEAD : 0;
+        while (j > jMin) {
+            Vector2 ahead = (j - 1 == 0) ? end : CellCenter(pathCells[j - 1]);
+            if (!Nav_IsWalkableLine(level, from, ahead, path->permission)) break;
+            j--;
+        }
+        Vector2 p = (j == 0) ? end : CellCenter(pathCells[j]);
+        if (path->pointCount == NAV_MAX_PATH_POINTS) {
+            path->truncated = true;
+            break;
+        }
+        path->points[path->pointCount++] = p;
+        from = p;
+        i = j;
+    }
+    if (path->pointCount == 0) path->points[path->pointCount++] = end;
+
+    path->status = NAV_PATH_READY;
+}
+
+// Records door group `door` as one the running search could not pass
+static void NoteBlocker(int door) {
+    if (search.blockerCount < 0) return;
+    int leader = doorGroup[door];
+    for (int i = 0; i < search.blockerCount; i++) {
+        if (search.blockers[i] == leader) return;
+    }
+    if (search.blockerCount == NAV_MAX_PATH_DOORS) {
+        search.blockerCount = -1; // Any door change retries it then
+        return;
+    }
+    search.blockers[search.blockerCount++] = leader;
+}
+
+static void EndSearch(const Level *level, int endCell) {
+    NavPath *path = search.path;
+    search.path = NULL;
+    if (endCell < 0) {
+        // The doors that stopped it, to know when to try again
+        path->status = NAV_PATH_FAILED;
+        path->doorCount = search.blockerCount;
+        if (search.blockerCount > 0) memcpy(path->doors, search.blockers, sizeof(search.blockers[0]) * (size_t)search.blockerCount);
+        return;
+    }
+    FinishPath(level, path, endCell);
+    CacheStore(path, search.startCell);
+}
+
+static void BeginSearch(const Level *level, NavPath *path) {
+    search.path = path;
+    search.request = path->request;
+    search.permission = path->permission;
+    search.expansions = 0;
+    search.blockerCount = 0;
+    search.startCell = NearestPassable(level, CellOf(path->start), path->permission);
+    search.goalCell = NearestPassable(level, path->goalCell, path->permission);
+    if (search.startCell < 0 || search.goalCell < 0) {
+        search.blockerCount = -1; // Not down to particular doors
+        EndSearch(level, -1);
+        return;
+    }
+
+    // Rooms first: an unreachable goal fails here at once instead of flooding the level,
+    // and the cell search is kept to the rooms of the route
+    search.inCorridor = false;
+    if (roomsValid) {
+        if (PlanRoute(level, search.startCell, path->start, search.goalCell, path->permission, NULL, 0) < 0) {
+            // Stopped by the closed doors around the rooms the route reached
+            for (int r = 0; r < roomCount; r++) {
+                if (routeCost[r] == FLT_MAX) continue;
+                for (int i = roomDoorStart[r]; i < roomDoorStart[r + 1]; i++) {
+                    if (!IsGroupPassable(level, roomDoors[i], path->permission)) NoteBlocker(roomDoors[i]);
+                }
+            }
+            EndSearch(level, -1);
+            return;
+        }
+        search.inCorridor = true;
+    }
+
+    searchStamp++;
+    openSet.count = 0;
+    Relax(search.startCell, -1, 0.0f);
+}
+
+// Expands up to `budget` cells of the active search. Returns the number expanded.
+static int RunSearch(const Level *level, int budget) {
+    int expanded = 0;
+    while (expanded < budget) {
+        if (openSet.count == 0 && search.inCorridor) {
+            // The route's rooms didn't connect on the cell level (tight doorway), search everywhere
+            search.inCorridor = false;
+            searchStamp++;
+            Relax(search.startCell, -1, 0.0f);
+        }
+        if (openSet.count == 0 || search.expansions >= NAV_MAX_SEARCH_EXPANSIONS) {
+            if (openSet.count > 0) search.blockerCount = -1; // Gave up before meeting every door
+            EndSearch(level, -1);
+            break;
+        }
+        int cell = HeapPop(&openSet);
+        expanded++;
+        search.expansions++;
+        if (cell == search.goalCell) {
+            EndSearch(level, cell);
+            break;
+        }
+
+        int cx = cell % grid.cols;
+        int cy = cell / grid.cols;
+        bool side[4];
+        for (int k = 0; k < 8; k++) {
+            int x = cx + neighborX[k];
+            int y = cy + neighborY[k];
+            bool inside = (x >= 0 && y >= 0 && x < grid.cols && y < grid.rows);
+            int n = y * grid.cols + x;
+            bool ok = inside && IsPassable(level, n, search.permission) &&
+                      (!search.inCorridor || InCorridor(n));
+            if (inside && !ok && !grid.blocked[n] && grid.door[n] != NAV_NO_DOOR &&
+                !IsDoorPassable(level, grid.door[n], search.permission)) {
+                NoteBlocker(grid.door[n]);
+            }
+            if (k < 4) {
+                side[k] = ok;
+            } else {
+                // No corner cutting: both side cells must be free too
+                ok = ok && side[(neighborX[k] > 0) ? 0 : 1] && side[(neighborY[k] > 0) ? 2 : 3];
+            }
+            if (ok) Relax(n, cell, gCost[cell] + neighborCost[k]);
+        }
+    }
+    return expanded;
+}
+
+// Grows the ring, unwrapping it so the oldest entry is first
+static bool GrowQueue(void) {
+    int capacity = (queueCapacity > 0) ? queueCapacity * 2 : NAV_QUEUE_INITIAL_CAPACITY;
+    NavPath **grown = (NavPath **)malloc(sizeof(NavPath *) * (size_t)capacity);
+    if (!grown) {
+        TraceLog(LOG_WARNING, "Failed to grow the path search queue to %d", capacity);
+        return false;
+    }
+    for (int i = 0; i < queueCount; i++) grown[i] = queue[(queueHead + i) % queueCapacity];
+    free(queue);
+    queue = grown;
+    queueCapacity = capacity;
+    queueHead = 0;
+    return true;
+}
+
+static void Enqueue(NavPath *path) {
+    if (path->queued) return;
+    if (queueCount == queueCapacity && !GrowQueue()) return; // Asked again next frame
+    queue[(queueHead + queueCount) % queueCapacity] = path;
+    queueCount++;
+    path->queued = true;
+}
+
+static void Request(NavPath *path, const Level *level, Vector2 goal, int goalCell, PermissionLevel permission) {
+    path->request++; // A search still running for the old goal is dropped by Nav_Update
+    if (path->staticVersion != level->staticVersion) path->queued = false; // Nav_Build emptied the queue
+
+    path->goal = goal;
+    path->goalCell = goalCell;
+    path->permission = permission;
+    path->staticVersion = level->staticVersion;
+    path->doorStamp = Level_DoorStamp(level);
+    path->doorCount = 0;
+    path->pointCount = 0;
+    path->next = 0;
+    path->truncated = false;
+
+    const NavPath *cached = CacheLookup(path, level);
+    if (cached) {
+        path->doorCount = cached->doorCount;
+        memcpy(path->doors, cached->doors, sizeof(path->doors[0]) * (size_t)cached->doorCount);
+        path->pointCount = cached->pointCount;
+        memcpy(path->points, cached->points, sizeof(path->points[0]) * (size_t)cached->pointCount);
+        path->truncated = cached->truncated;
+        // Same goal cell: end at this goal instead of the cached one, unless that point is not the goal
+        if (!path->truncated && IsPassable(level, goalCell, permission)) path->points[path->pointCount - 1] = goal;
+        path->status = NAV_PATH_READY;
+        return;
+    }
+
+    path->status = NAV_PATH_PENDING; // Queued by Nav_Enqueue
+}
+
+// Records the doors a field depends on: those with cells in its window that can stop its
+// permission (a door the permission may pass anyway doesn't change any cost)
+static void RecordWindowDoors(const Level *level, NavFlowWindow *w, PermissionLevel permission) {
+    w->doorCount = 0;
+    w->doorStamp = Level_DoorStamp(level);
+    // Door cells reach up to the clearance past the door
+    float pad = grid.clearance;
+    Rectangle window = {
+        grid.origin.x + (float)w->x0 * grid.cellSize - pad, grid.origin.y + (float)w->y0 * grid.cellSize - pad,
+        (float)w->cols * grid.cellSize + pad * 2.0f, (float)w->rows * grid.cellSize + pad * 2.0f
+    };
+    for (int d = 0; d < level->doorCount; d++) {
+        if (permission >= level->doors[d].requiredPerm || !CheckCollisionRecs(level->doors[d].rect, window)) continue;
+        if (w->doorCount == NAV_FLOW_MAX_DOORS) {
+            w->doorCount = -1;
+            return;
+        }
+        w->doors[w->doorCount] = d;
+        w->doorVersions[w->doorCount] = level->doorVersions[d];
+        w->doorCount++;
+    }
+}
+
+static bool WindowDoorsUnchanged(const NavFlowWindow *w, const Level *level) {
+    if (w->doorCount < 0) return w->doorStamp == Level_DoorStamp(level);
+    for (int k = 0; k < w->doorCount; k++) {
+        if (level->doorVersions[w->doors[k]] != w->doorVersions[k]) return false;
+    }
+    return true;
+}
+
+static bool FlowIsStale(const NavFlowField *f, const Level *level) {
+    return !f->ready ||
+           f->front.targetCell != CellOf(f->wantedTarget) ||
+           f->front.staticVersion != level->staticVersion ||
+           !WindowDoorsUnchanged(&f->front, level);
+}
+
+static void BeginFlowBuild(const Level *level, int field) {
+    NavFlowWindow *w = &flowBuild.back;
+    PermissionLevel permission = (PermissionLevel)field;
+    flowBuild.field = field;
+    w->targetCell = CellOf(flowFields[field].wantedTarget);
+    w->staticVersion = level->staticVersion;
+
+    int tx = w->targetCell % grid.cols;
+    int ty = w->targetCell / grid.cols;
+    w->x0 = ClampInt(tx - NAV_FLOW_RADIUS, 0, grid.cols - 1);
+    w->y0 = ClampInt(ty - NAV_FLOW_RADIUS, 0, grid.rows - 1);
+    w->cols = ClampInt(tx + NAV_FLOW_RADIUS, 0, grid.cols - 1) - w->x0 + 1;
+    w->rows = ClampInt(ty + NAV_FLOW_RADIUS, 0, grid.rows - 1) - w->y0 + 1;
+    RecordWindowDoors(level, w, permission);
+    for (int i = 0; i < w->cols * w->rows; i++) w->cost[i] = FLT_MAX;
+
+    flowBuild.heap = (NavHeap){ flowBuild.items, flowBuild.pos, w->cost, 0 };
+    int seed = NearestPassable(level, w->targetCell, permission);
+    if (seed < 0) return; // Nothing reaches it, the field ends up empty
+    int local = (seed / grid.cols - w->y0) * w->cols + (seed % grid.cols - w->x0);
+    w->cost[local] = 0.0f;
+    HeapPush(&flowBuild.heap, local);
+}
+
+// Settles up to `budget` cells of the field being built. Returns the number settled.
+static int RunFlowBuild(const Level *level, int budget) {
+    NavFlowWindow *w = &flowBuild.back;
+    NavHeap *h = &flowBuild.heap;
+    PermissionLevel permission = (PermissionLevel)flowBuild.field;
+
+    int settled = 0;
+    while (settled < budget && h->count > 0) {
+        int local = HeapPop(h);
+        settled++;
+
+        int lx = local % w->cols;
+        int ly = local / w->cols;
+        bool side[4];
+        for (int k = 0; k < 8; k++) {
+            int x = lx + neighborX[k];
+            int y = ly + neighborY[k];
+            bool ok = (x >= 0 && y >= 0 && x < w->cols && y < w->rows) &&
+                      IsPassable(level, (w->y0 + y) * grid.cols + (w->x0 + x), permission);
+            if (k < 4) side[k] = ok;
+            else ok = ok && side[(neighborX[k] > 0) ? 0 : 1] && side[(neighborY[k] > 0) ? 2 : 3];
+            if (!ok) continue;
+
+            int n = y * w->cols + x;
+            float c = w->cost[local] + neighborCost[k];
+            if (w->cost[n] == FLT_MAX) {
+                w->cost[n] = c;
+                HeapPush(h, n);
+            } else if (h->pos[n] != NAV_HEAP_CLOSED && c < w->cost[n]) {
+                w->cost[n] = c;
+                HeapUp(h, h->pos[n]);
+            }
+        }
+    }
+
+    if (h->count == 0) {
+        NavFlowField *f = &flowFields[flowBuild.field];
+        f->front = *w;
+        f->ready = true;
+        flowBuild.field = -1;
+    }
+    return settled;
+}
+
+// Spends up to `budget` on the flow fields sampled last frame that no longer match their target
+static int UpdateFlowFields(const Level *level, int budget) {
+    int used = 0;
+    while (used < budget) {
+        if (flowBuild.field < 0) {
+            // Round-robin over the stale fields, starting after the last one built
+            static int nextField = 0;
+            for (int i = 0; i < NAV_FLOW_FIELDS && flowBuild.field < 0; i++) {
+                int field = (nextField + i) % NAV_FLOW_FIELDS;
+                const NavFlowField *f = &flowFields[field];
+                if (f->wantedFrame == navFrame && FlowIsStale(f, level)) {
+                    BeginFlowBuild(level, field);
+                    nextField = field + 1;
+                }
+            }
+            if (flowBuild.field < 0) break;
+        }
+        used += RunFlowBuild(level, budget - used);
+    }
+    return used;
+}
+
+bool Nav_SampleFlow(const Level *level, Vector2 position, Vector2 target, PermissionLevel permission, Vector2 *direction) {
+    if (grid.cols <= 0) return false;
+
+    const NavFlowField *f = &flowFields[ClampInt((int)permission, 0, NAV_FLOW_FIELDS - 1)];
+
+    // A field for an older target cell is still close enough to follow while the new one builds
+    const NavFlowWindow *w = &f->front;
+    if (!f->ready || w->staticVersion != level->staticVersion) return false;
+
+    int cell = CellOf(position);
+    int lx = cell % grid.cols - w->x0;
+    int ly = cell / grid.cols - w->y0;
+    if (lx < 0 || ly < 0 || lx >= w->cols || ly >= w->rows) return false;
+    // An agent brushing a wall stands in a blocked cell (FLT_MAX), any reached neighbor leads out
+    float cost = w->cost[ly * w->cols + lx];
+    if (cost == 0.0f) {
+        *direction = Vector2Normalize(Vector2Subtract(target, position));
+        return true;
+    }
+
+    // Downhill: the neighbor closest to the target
+    int best = -1;
+    float bestCost = cost;
+    bool side[4];
+    for (int k = 0; k < 8; k++) {
+        int x = lx + neighborX[k];
+        int y = ly + neighborY[k];
+        float c = (x >= 0 && y >= 0 && x < w->cols && y < w->rows) ? w->cost[y * w->cols + x] : FLT_MAX;
+        if (k < 4) side[k] = (c != FLT_MAX);
+        else if (!side[(neighborX[k] > 0) ? 0 : 1] || !side[(neighborY[k] > 0) ? 2 : 3]) continue;
+        if (c < bestCost) {
+            best = (w->y0 + y) * grid.cols + (w->x0 + x);
+            bestCost = c;
+        }
+    }
+    if (best < 0) return false;
+    *direction = Vector2Normalize(Vector2Subtract(CellCenter(best), position));
+    return true;
+}
+
+void Nav_WantFlow(Vector2 target, PermissionLevel permission) {
+    if (grid.cols <= 0) return;
+    NavFlowField *f = &flowFields[ClampInt((int)permission, 0, NAV_FLOW_FIELDS - 1)];
+    f->wantedTarget = target;
+    f->wantedFrame = navFrame;
+}
+
+void Nav_Enqueue(NavPath *path) {
+    if (grid.cols <= 0 || path->status != NAV_PATH_PENDING) return;
+    Enqueue(path);
+}
+
+void Nav_Update(const Level *level) {
+    if (grid.cols <= 0) return;
+
+    // Flow fields get at most half, so path searches keep moving during a chase
+    int budget = NAV_EXPANSIONS_PER_FRAME;
+    budget -= UpdateFlowFields(level, budget / 2);
+    while (budget > 0) {
+        if (!search.path) {
+            if (queueCount == 0) break;
+            NavPath *path = queue[queueHead];
+            queueHead = (queueHead + 1) % queueCapacity;
+            queueCount--;
+            path->queued = false;
+            if (path->status != NAV_PATH_PENDING) continue; // Reset or served from the cache meanwhile
+            BeginSearch(level, path);
+            continue;
+        }
+        if (search.path->request != search.request) {
+            search.path = NULL; // Asked again (new goal or reset) since it started, requeued then
+            continue;
+        }
+        budget -= RunSearch(level, budget);
+    }
+    navFrame++;
+}
+
+NavSteerResult Nav_Steer(NavPath *path, const Level *level, Vector2 position, Vector2 goal,
+                         PermissionLevel permission, Vector2 *waypoint) {
+    if (grid.cols <= 0) return NAV_STEER_UNREACHABLE;
+
+    int goalCell = CellOf(goal);
+    path->start = position;
+
+    bool stale = path->status == NAV_PATH_NONE ||
+                 path->staticVersion != level->staticVersion ||
+                 path->goalCell != goalCell ||
+                 path->permission != permission;
+    if (!stale && path->status == NAV_PATH_READY) {
+        stale = !DoorsPassable(path, level) || (path->truncated && path->next >= path->pointCount);
+    }
+    if (!stale && path->status == NAV_PATH_FAILED) stale = BlockersPassable(path, level);
+
+    if (stale) {
+        Request(path, level, goal, goalCell, permission);
+    } else if (path->status == NAV_PATH_PENDING) {
+        path->goal = goal;
+    }
+
+    switch (path->status) {
+        case NAV_PATH_PENDING:
+            return NAV_STEER_WAIT;
+        case NAV_PATH_READY:
+            break;
+        default:
+            return NAV_STEER_UNREACHABLE;
+    }
+
+    // Reached waypoints are dropped, and the next one is skipped once the one after it is in plain line
+    float reach = grid.cellSize * 0.5f;
+    while (path->next < path->pointCount && Vector2DistanceSqr(position, path->points[path->next]) < reach * reach) {
+        path->next++;
+    }
+    if (path->next >= path->pointCount) return NAV_STEER_ARRIVED;
+    if (path->next + 1 < path->pointCount &&
+        Nav_IsWalkableLine(level, position, path->points[path->next + 1], permission)) {
+        path->next++;
+    }
+
+    *waypoint = path->points[path->next];
+    return NAV_STEER_FOLLOW;
+}
+
+void Nav_ResetPath(NavPath *path) {
+    path->request++;
+    // Left in the queue if queued, Nav_Update skips it
+    path->status = NAV_PATH_NONE;
+    path->pointCount = 0;
+    path->next = 0;
+}
+
+void Nav_CancelSearches(void) {
+    search.path = NULL;
+    queueHead = 0;
+    queueCount = 0;
+}
+
+int Nav_GetRoom(Vector2 position) {
+    if (grid.cols <= 0 || !roomsValid) return -1;
+    return grid.room[CellOf(position)];
+}
+
+int Nav_PlanRoute(const Level *level, Vector2 from, Vector2 to, PermissionLevel permission, int *doors, int maxDoors) {
+    if (grid.cols <= 0 || !roomsValid) return -1;
+    int startCell = NearestPassable(level, CellOf(from), permission);
+    int goalCell = NearestPassable(level, CellOf(to), permission);
+    if (startCell < 0 || goalCell < 0) return -1;
+    return PlanRoute(level, startCell, from, goalCell, permission, doors, maxDoors);
+}
+
+bool Nav_SpreadSound(const Level *level, Vector2 origin, float range, float closedDoorCost) {
+    soundValid = false;
+    if (grid.cols <= 0 || !roomsValid) return false;
+
+    // Sound ignores permissions, so the admin level only matters for skipping walls
+    int startRooms[NAV_MAX_DOOR_ROOMS];
+    int startCell = NearestPassable(level, CellOf(origin), PERM_ADMIN);
+    int startCount = (startCell >= 0) ? CellRooms(startCell, startRooms) : 0;
+
+    for (int r = 0; r < roomCount; r++) soundCost[r] = FLT_MAX;
+    NavHeap heap = { routeItems, routePos, soundCost, 0 };
+    for (int i = 0; i < startCount; i++) {
+        int r = startRooms[i];
+        soundCost[r] = 0.0f;
+        soundEntry[r] = origin;
+        HeapPush(&heap, r);
+    }
+
+    // Dijkstra over the portal graph, like PlanRoute, cut off at `range`
+    while (heap.count > 0) {
+        int r = HeapPop(&heap);
+        for (int i = roomDoorStart[r]; i < roomDoorStart[r + 1]; i++) {
+            int d = roomDoors[i];
+            float cost = soundCost[r] + Vector2Distance(soundEntry[r], doorCenters[d]);
+            if (!IsGroupOpen(level, d)) cost += closedDoorCost;
+            if (cost > range) continue;
+            for (int k = 0; k < doorRoomCount[d]; k++) {
+                int next = doorRooms[d][k];
+                if (next == r || cost >= soundCost[next]) continue;
+                bool queued = (soundCost[next] != FLT_MAX);
+                if (queued && heap.pos[next] == NAV_HEAP_CLOSED) continue;
+                soundCost[next] = cost;
+                soundEntry[next] = doorCenters[d];
+                if (queued) HeapUp(&heap, heap.pos[next]);
+                else HeapPush(&heap, next);
+            }
+        }
+    }
+    soundValid = true;
+    return true;
+}
+
+float Nav_SoundDistance(const Level *level, Vector2 listener) {
+    if (!soundValid) return FLT_MAX;
+    int cell = NearestPassable(level, CellOf(listener), PERM_ADMIN);
+    if (cell < 0) return FLT_MAX;
+
+    int rooms[NAV_MAX_DOOR_ROOMS];
+    int count = CellRooms(cell, rooms);
+    float best = FLT_MAX;
+    for (int i = 0; i < count; i++) {
+        int r = rooms[i];
+        if (soundCost[r] == FLT_MAX) continue;
+        best = fminf(best, soundCost[r] + Vector2Distance(soundEntry[r], listener));
+    }
+    return best;
+}
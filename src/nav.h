@@ -0,0 +1,135 @@
+#ifndef NAV_H
+#define NAV_H
+
+#include "levels.h"
+
+// Walkability grid over the current level plus an A* path service for walkers.
+// Nav_Build rasterizes walls (blocked) and doors (passable by permission or when
+// open) into NAV_CELL_SIZE cells. A cell is only walkable if a NAV_AGENT_RADIUS
+// circle fits anywhere inside it, so a walker on a path never rubs a wall.
+// Searches are queued and run by Nav_Update under a per-frame node-expansion
+// budget, so many enemies asking at once spread over several frames instead of
+// spiking one. Finished paths are cached per agent (NavPath) and in a small shared
+// cache, and stay valid until the goal moves to another cell, a door on the path
+// closes on the agent, or the level geometry is rebuilt.
+//
+// Above the cells sits a portal graph: rooms (connected walkable areas between doors)
+// linked by the doors between them. A search first plans its route over rooms, which
+// fails unreachable goals in microseconds and keeps the cell search inside the rooms
+// of the route.
+//
+// For chasing one shared target (the player) there are flow fields instead: one
+// Dijkstra from the target over a window of the grid, per permission level, that
+// any number of agents sample in O(1). A field is rebuilt (within the same budget)
+// when its target moves to another cell; the previous one is sampled meanwhile.
+//
+// Nav_Steer and Nav_SampleFlow only write the agent's own NavPath, so agents may steer
+// from worker threads. What they need from the shared state (a search queued, a field
+// kept up to date) is asked for afterwards on the main thread with Nav_Enqueue and
+// Nav_WantFlow, in a fixed order so runs stay deterministic.
+
+#define NAV_CELL_SIZE 16.0f
+#define NAV_MAX_CELLS 65536
+#define NAV_AGENT_RADIUS 20.0f // Walker radius (see InitEnemy)
+#define NAV_MAX_PATH_POINTS 64
+#define NAV_MAX_PATH_DOORS 16 // Doors one path goes through, a path past more is cut before the next
+#define NAV_EXPANSIONS_PER_FRAME 2048
+#define NAV_MAX_SEARCH_EXPANSIONS 20000 // A search expanding more than this fails (goal unreachable)
+#define NAV_CACHE_SIZE 16
+#define NAV_MAX_ROOMS 1024
+#define NAV_MAX_DOOR_ROOMS 8 // Rooms a single door can connect
+#define NAV_FLOW_RADIUS 64 // Cells a flow field reaches around its target (each way)
+#define NAV_FLOW_CELLS ((NAV_FLOW_RADIUS * 2 + 1) * (NAV_FLOW_RADIUS * 2 + 1))
+#define NAV_FLOW_FIELDS (PERM_ADMIN + 1) // One per permission level
+
+typedef enum {
+    NAV_PATH_NONE = 0,
+    NAV_PATH_PENDING, // Queued or being searched
+    NAV_PATH_READY,
+    NAV_PATH_FAILED   // No route with the agent's permission
+} NavPathStatus;
+
+typedef enum {
+    NAV_STEER_WAIT = 0,    // Search still running, hold position
+    NAV_STEER_FOLLOW,      // Move toward the returned waypoint
+    NAV_STEER_ARRIVED,     // End of the path reached
+    NAV_STEER_UNREACHABLE  // No path, caller decides (e.g. walk straight)
+} NavSteerResult;
+
+// Per-agent path and request state. Zero-initialized means no path.
+typedef struct {
+    NavPathStatus status;
+    Vector2 start;  // Agent position, refreshed on every Nav_Steer
+    Vector2 goal;
+    int goalCell;
+    PermissionLevel permission;
+    bool queued;
+    unsigned int request; // Bumped by every new request or reset
+
+    // Cache key of the current result
+    unsigned int staticVersion;
+    unsigned int doorStamp; // Level_DoorStamp at the request, retries a failed search with doorCount -1
+    int doorCount;          // Doors the path goes through. Failed: door groups that stopped it (-1 if too many)
+    int doors[NAV_MAX_PATH_DOORS];
+
+    bool truncated; // Path had more than NAV_MAX_PATH_POINTS or NAV_MAX_PATH_DOORS, search again at its end
+    int next;       // Waypoint being walked to
+    int pointCount;
+    Vector2 points[NAV_MAX_PATH_POINTS];
+} NavPath;
+
+// Rebuilds the grid for `level` and drops pending searches and cached paths.
+// Called by Level_BuildCollision. Returns false if out of memory, there is no
+// navigation then (agents get NAV_STEER_UNREACHABLE).
+bool Nav_Build(const Level *level);
+
+// Runs queued searches and flow field rebuilds for up to NAV_EXPANSIONS_PER_FRAME node
+// expansions. Call once per frame, after the agents.
+void Nav_Update(const Level *level);
+
+// Steers an agent at `position` toward `goal` (starting a new request when needed).
+// On NAV_STEER_FOLLOW *waypoint is the point to move to. On NAV_STEER_WAIT the search
+// still has to be queued with Nav_Enqueue.
+NavSteerResult Nav_Steer(NavPath *path, const Level *level, Vector2 position, Vector2 goal,
+                         PermissionLevel permission, Vector2 *waypoint);
+
+// Direction to move from `position` toward `target` along the flow field of `permission`.
+// False when there is no field yet or the position is outside it or cut off from the target.
+// Fields are only kept for targets passed to Nav_WantFlow.
+bool Nav_SampleFlow(const Level *level, Vector2 position, Vector2 target, PermissionLevel permission,
+                    Vector2 *direction);
+
+// Keeps the flow field of `permission` built toward `target` (call every frame it is sampled)
+void Nav_WantFlow(Vector2 target, PermissionLevel permission);
+
+// Queues the search of a path left pending by Nav_Steer (no-op otherwise or if already queued).
+// If the queue can't grow the request is dropped, the agent asks again next frame.
+void Nav_Enqueue(NavPath *path);
+
+// Room (connected walkable area between doors) containing `position`, or -1 in walls and doorways
+int Nav_GetRoom(Vector2 position);
+
+// Plans the doors to go through from `from` to `to` over the room graph only (no cell search),
+// using doors `permission` can pass or that stand open. Writes up to maxDoors door indices in
+// route order and returns the route's door count (0 = same room), or -1 if `to` can't be reached.
+int Nav_PlanRoute(const Level *level, Vector2 from, Vector2 to, PermissionLevel permission, int *doors, int maxDoors);
+
+// Spreads a sound from `origin` over the room graph: freely through open doors, and through
+// closed ones (whatever their permission) for `closedDoorCost` extra distance, up to `range`.
+// Nav_SoundDistance then tells how far it traveled to reach a point. False without a room graph.
+bool Nav_SpreadSound(const Level *level, Vector2 origin, float range, float closedDoorCost);
+
+// Distance the last spread sound traveled to reach `listener` (FLT_MAX if it didn't)
+float Nav_SoundDistance(const Level *level, Vector2 listener);
+
+// Forgets the agent's path (and cancels its pending search)
+void Nav_ResetPath(NavPath *path);
+
+// Drops every queued and running search without touching the paths, for when the
+// paths themselves move or are freed. Their owner must clear them (e.g. to {0}).
+void Nav_CancelSearches(void);
+
+// True if a NAV_AGENT_RADIUS circle can go straight from `a` to `b` with `permission`
+bool Nav_IsWalkableLine(const Level *level, Vector2 a, Vector2 b, PermissionLevel permission);
+
+#endif // NAV_H
@@ -0,0 +1,35 @@
+#include "noise.h"
+#include "nav.h"
+#include "../raylib/src/raymath.h"
+
+void Noise_Emit(NoiseQueue *queue, Vector2 position, float loudness) {
+    if (queue->count == MAX_NOISE_EVENTS) return;
+    queue->events[queue->count++] = (NoiseEvent){ position, loudness };
+}
+
+static void Alert(EnemyAI *enemy, Vector2 position) {
+    // Enemies fighting or being choked already know where the player is
+    if (enemy->state == STATE_ATTACK || enemy->state == STATE_BEING_CHOKED) return;
+    enemy->state = STATE_SEARCH;
+    enemy->lastKnownPlayerPos = position;
+    enemy->searchTimer = enemy->IGotHitImSearchingThePlayerForHowManySeconds;
+}
+
+void Noise_Propagate(NoiseQueue *queue, Level *level) {
+    for (int n = 0; n < queue->count; n++) {
+        const NoiseEvent *noise = &queue->events[n];
+        // Without a room graph (no nav grid) sound goes straight through walls
+        bool spread = Nav_SpreadSound(level, noise->position, noise->loudness, NOISE_CLOSED_DOOR_COST);
+
+        for (int i = 0; i < level->enemyCount; i++) {
+            const EntityBody *body = &level->enemyBodies[i];
+            if (!body->active) continue;
+            // Sound never travels less than the straight line
+            if (Vector2DistanceSqr(noise->position, body->position) > noise->loudness * noise->loudness) continue;
+            float dist = spread ? Nav_SoundDistance(level, body->position)
+                                : Vector2Distance(noise->position, body->position);
+            if (dist <= noise->loudness) Alert(&level->enemyAI[i], noise->position);
+        }
+    }
+    queue->count = 0;
+}
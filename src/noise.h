@@ -0,0 +1,36 @@
+#ifndef NOISE_H
+#define NOISE_H
+
+#include "levels.h"
+
+// Noise the player makes (gunfire, melee, doors). Events are collected during the
+// frame and propagated once at its end: each spreads through the rooms and doors of
+// the nav portal graph, losing NOISE_CLOSED_DOOR_COST at every closed door, and any
+// enemy it reaches within its loudness goes to search the noise position.
+
+#define MAX_NOISE_EVENTS 32
+
+// Loudness: how far a noise carries, in pixels of walking distance
+#define NOISE_GUNSHOT_LOUDNESS 1500.0f
+#define NOISE_MELEE_LOUDNESS 250.0f
+#define NOISE_CHOKE_LOUDNESS 120.0f
+#define NOISE_DOOR_LOUDNESS 350.0f
+#define NOISE_CLOSED_DOOR_COST 800.0f // A closed door muffles like this much extra distance
+
+typedef struct {
+    Vector2 position;
+    float loudness;
+} NoiseEvent;
+
+typedef struct {
+    NoiseEvent events[MAX_NOISE_EVENTS];
+    int count;
+} NoiseQueue;
+
+// Records a noise for this frame (dropped if the queue is full)
+void Noise_Emit(NoiseQueue *queue, Vector2 position, float loudness);
+
+// Alerts the enemies that hear the queued noises and empties the queue
+void Noise_Propagate(NoiseQueue *queue, Level *level);
+
+#endif // NOISE_H
@@ -0,0 +1,192 @@
+#include "pickups.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int CellCoord(float v) {
+    return (int)floorf(v / PICKUPS_CELL_SIZE);
+}
+
+static int BucketOf(int cx, int cy) {
+    unsigned int h = (unsigned int)cx * 73856093u ^ (unsigned int)cy * 19349663u;
+    return (int)(h & (PICKUPS_BUCKETS - 1));
+}
+
+static int BucketOfPosition(Vector2 position) {
+    return BucketOf(CellCoord(position.x), CellCoord(position.y));
+}
+
+static void Link(PickupStore *store, int index) {
+    int bucket = BucketOfPosition(store->bodies[index].position);
+    int head = store->heads[bucket];
+    store->bodies[index].next = head;
+    store->items[index].prev = PICKUP_NONE;
+    if (head != PICKUP_NONE) store->items[head].prev = index;
+    store->heads[bucket] = index;
+}
+
+static void Unlink(PickupStore *store, int index) {
+    int prev = store->items[index].prev;
+    int next = store->bodies[index].next;
+    if (prev != PICKUP_NONE) store->bodies[prev].next = next;
+    else store->heads[BucketOfPosition(store->bodies[index].position)] = next;
+    if (next != PICKUP_NONE) store->items[next].prev = prev;
+}
+
+static bool Grow(PickupStore *store) {
+    int capacity = (store->capacity > 0) ? store->capacity * 2 : PICKUPS_INITIAL_CAPACITY;
+    PickupBody *bodies = (PickupBody *)realloc(store->bodies, sizeof(PickupBody) * (size_t)capacity);
+    if (!bodies) {
+        TraceLog(LOG_WARNING, "Failed to grow pickups to %d", capacity);
+        return false;
+    }
+    store->bodies = bodies;
+    Pickup *items = (Pickup *)realloc(store->items, sizeof(Pickup) * (size_t)capacity);
+    if (!items) {
+        TraceLog(LOG_WARNING, "Failed to grow pickups to %d", capacity);
+        return false;
+    }
+    store->items = items;
+    store->capacity = capacity;
+    return true;
+}
+
+void Pickups_Clear(PickupStore *store) {
+    store->count = 0;
+    store->maxRadius = 0.0f;
+    for (int b = 0; b < PICKUPS_BUCKETS; b++) store->heads[b] = PICKUP_NONE;
+}
+
+Pickup *Pickups_Add(PickupStore *store, PickupType type, Vector2 position, float radius) {
+    if (store->count == store->capacity && !Grow(store)) return NULL;
+
+    int index = store->count++;
+    store->bodies[index] = (PickupBody){ position, radius, PICKUP_NONE };
+    memset(&store->items[index], 0, sizeof(Pickup));
+    store->items[index].type = type;
+    Link(store, index);
+    store->maxRadius = fmaxf(store->maxRadius, radius);
+    return &store->items[index];
+}
+
+void Pickups_Remove(PickupStore *store, int index) {
+    if (index < 0 || index >= store->count) return;
+    Unlink(store, index);
+
+    int last = --store->count;
+    if (index == last) return;
+
+    // The last pickup takes the freed index: point its chain neighbours at it
+    store->bodies[index] = store->bodies[last];
+    store->items[index] = store->items[last];
+    int prev = store->items[index].prev;
+    int next = store->bodies[index].next;
+    if (prev != PICKUP_NONE) store->bodies[prev].next = index;
+    else store->heads[BucketOfPosition(store->bodies[index].position)] = index;
+    if (next != PICKUP_NONE) store->items[next].prev = index;
+}
+
+void Pickups_Move(PickupStore *store, int index, Vector2 position) {
+    if (index < 0 || index >= store->count) return;
+    if (BucketOfPosition(position) == BucketOfPosition(store->bodies[index].position)) {
+        store->bodies[index].position = position;
+        return;
+    }
+    Unlink(store, index);
+    store->bodies[index].position = position;
+    Link(store, index);
+}
+
+PickupIter Pickups_Query(const PickupStore *store, Rectangle area) {
+    PickupIter it = { .store = store, .area = area, .item = PICKUP_NONE };
+
+    // Empty range: Next() fails immediately
+    it.cy = 1;
+    it.cy1 = 0;
+    if (store->count == 0) return it;
+
+    float r = store->maxRadius;
+    it.cx0 = CellCoord(area.x - r);
+    it.cx1 = CellCoord(area.x + area.width + r);
+    it.cy = CellCoord(area.y - r);
+    it.cy1 = CellCoord(area.y + area.height + r);
+
+    // Covering more cells than there are pickups: scanning them all is cheaper
+    float cells = (float)(it.cx1 - it.cx0 + 1) * (float)(it.cy1 - it.cy + 1);
+    if (cells > (float)store->count) {
+        it.linear = true;
+        it.cy = it.cy1 = 0;
+        it.item = 0;
+        return it;
+    }
+
+    it.cx = it.cx0;
+    it.item = store->heads[BucketOf(it.cx, it.cy)];
+    return it;
+}
+
+static bool Overlaps(const PickupBody *body, Rectangle area) {
+    return body->position.x + body->radius >= area.x && body->position.x - body->radius <= area.x + area.width &&
+           body->position.y + body->radius >= area.y && body->position.y - body->radius <= area.y + area.height;
+}
+
+bool PickupIter_Next(PickupIter *it, int *index) {
+    const PickupStore *store = it->store;
+    while (it->cy <= it->cy1) {
+        while (it->item != PICKUP_NONE) {
+            int i = it->item;
+            const PickupBody *body = &store->bodies[i];
+            if (it->linear) {
+                it->item = (i + 1 < store->count) ? i + 1 : PICKUP_NONE;
+            } else {
+                it->item = body->next;
+                // The chain also holds the other cells hashing to this bucket
+                if (CellCoord(body->position.x) != it->cx || CellCoord(body->position.y) != it->cy) continue;
+            }
+            if (Overlaps(body, it->area)) {
+                *index = i;
+                return true;
+            }
+        }
+        if (it->linear) break;
+
+        // Advance to next cell in the range
+        if (++it->cx > it->cx1) {
+            it->cx = it->cx0;
+            if (++it->cy > it->cy1) break;
+        }
+        it->item = store->heads[BucketOf(it->cx, it->cy)];
+    }
+    it->cy = 1; // Stay exhausted
+    it->cy1 = 0;
+    return false;
+}
+
+int Pickups_Overlapping(const PickupStore *store, Vector2 center, float radius, int *out, int max) {
+    int count = 0;
+    Rectangle area = { center.x - radius, center.y - radius, radius * 2.0f, radius * 2.0f };
+    PickupIter it = Pickups_Query(store, area);
+    int i;
+    while (count < max && PickupIter_Next(&it, &i)) {
+        const PickupBody *body = &store->bodies[i];
+        if (!CheckCollisionCircles(center, radius, body->position, body->radius)) continue;
+
+        // Insertion sort, highest index first
+        int j = count++;
+        while (j > 0 && out[j - 1] < i) {
+            out[j] = out[j - 1];
+            j--;
+        }
+        out[j] = i;
+    }
+    return count;
+}
+
+void Pickups_Free(PickupStore *store) {
+    free(store->bodies);
+    free(store->items);
+    store->bodies = NULL;
+    store->items = NULL;
+    store->capacity = 0;
+    Pickups_Clear(store);
+}
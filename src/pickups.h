@@ -0,0 +1,87 @@
+#ifndef PICKUPS_H
+#define PICKUPS_H
+
+#include "types.h"
+#include <stdbool.h>
+
+// Items lying on the floor (masks, keycards, guns), all in one table.
+// Like a Pool the table is packed: removing moves the last pickup into the freed
+// index. Positions and radii (what proximity checks read) are kept apart from the
+// payloads, and a hashed uniform grid over the positions is updated on every add,
+// remove and move, so a query only walks the pickups in the cells it covers, however
+// many lie elsewhere on the map.
+
+#define PICKUPS_CELL_SIZE 128.0f
+#define PICKUPS_BUCKETS 1024 // Power of two, cells hashing to one bucket share its chain
+#define PICKUPS_INITIAL_CAPACITY 64
+#define PICKUP_NONE -1
+
+typedef enum {
+    PICKUP_MASK = 0,
+    PICKUP_CARD,
+    PICKUP_GUN
+} PickupType;
+
+// What a query reads
+typedef struct {
+    Vector2 position;
+    float radius;
+    int next; // Next pickup in the bucket chain (PICKUP_NONE ends it)
+} PickupBody;
+
+typedef struct {
+    PickupType type;
+    int prev; // Previous pickup in the bucket chain (PICKUP_NONE: bucket head)
+    union {
+        Color maskColor; // PICKUP_MASK
+        struct {
+            PermissionLevel level;
+            Color color;
+        } card;          // PICKUP_CARD
+        Gun gun;         // PICKUP_GUN
+    };
+} Pickup;
+
+typedef struct {
+    PickupBody *bodies;
+    Pickup *items;
+    int count;
+    int capacity;
+    float maxRadius; // Largest radius added since the last clear, queries grow by it
+    int heads[PICKUPS_BUCKETS];
+} PickupStore;
+
+typedef struct {
+    const PickupStore *store;
+    Rectangle area;
+    int cx0, cx1, cy1;
+    int cx, cy;
+    int item;
+    bool linear; // Walking the whole table instead of the cells
+} PickupIter;
+
+// Empties the store (keeping its storage). Call it once before first use.
+void Pickups_Clear(PickupStore *store);
+
+// Adds a pickup and returns its zeroed payload with `type` set (NULL if out of memory).
+// Its index is store->count - 1 until something is removed.
+Pickup *Pickups_Add(PickupStore *store, PickupType type, Vector2 position, float radius);
+
+void Pickups_Remove(PickupStore *store, int index);
+
+void Pickups_Move(PickupStore *store, int index, Vector2 position);
+
+// Iterates the indices of pickups whose circle's bounds overlap `area`, each once.
+// The store must not change during the iteration.
+PickupIter Pickups_Query(const PickupStore *store, Rectangle area);
+bool PickupIter_Next(PickupIter *it, int *index);
+
+// Writes the indices of pickups whose circle overlaps the given one to `out` (at
+// most `max`), highest index first: removing them in that order leaves the
+// remaining ones where they were.
+int Pickups_Overlapping(const PickupStore *store, Vector2 center, float radius, int *out, int max);
+
+// Frees the storage, the store stays usable (and empty)
+void Pickups_Free(PickupStore *store);
+
+#endif // PICKUPS_H
@@ -41,7 +41,18 @@ Entity InitPlayer(Vector2 spawnPos, Identity startIdentity) {
   return player;
 }
 
-void UpdatePlayer(Entity *player, Level *currentLevel, float dt, bool godMode) {
+// True if a circle at `pos` overlaps an active enemy (only the enemies binned near it are tested)
+static bool HitsEnemy(const Level *currentLevel, const EntityGrid *enemyGrid, Vector2 pos, float radius) {
+    EntityGridIter it = EntityGrid_Query(enemyGrid, Gameplay_CircleBounds(pos, radius));
+    int i;
+    while (EntityGridIter_Next(&it, &i)) {
+        const EntityBody *enemy = &currentLevel->enemyBodies[i];
+        if (enemy->active && CheckCollisionCircles(pos, radius, enemy->position, enemy->radius)) return true;
+    }
+    return false;
+}
+
+void UpdatePlayer(Entity *player, Level *currentLevel, const EntityGrid *enemyGrid, float dt, bool godMode) {
   // Update Masks
   Masks_Update(player, dt);
 
@@ -66,18 +77,13 @@ void UpdatePlayer(Entity *player, Level *currentLevel, float dt, bool godMode) {
     Vector2 xPos = newPos;
     xPos.x += delta.x;
 
-    bool blocked_x = false;
-    for (int i = 0; i < currentLevel->wallCount; i++) {
-      if (CheckCollisionCircleRotatedRect(xPos, player->radius,
-                    currentLevel->walls[i].rect, currentLevel->walls[i].rotation)) {
-        blocked_x = true;
-        break;
-      }
-    }
+    bool blocked_x = Gameplay_CircleHitsWall(currentLevel, xPos, player->radius);
 
     if (!godMode) {
         PermissionLevel myLevel = player->inventory.card.level;
-        for (int i = 0; i < currentLevel->doorCount && !blocked_x; i++) {
+        LevelGridIter doorIt = LevelGrid_Query(&currentLevel->grid, GRID_LAYER_DOORS, Gameplay_CircleBounds(xPos, player->radius));
+        int i;
+        while (!blocked_x && LevelGridIter_Next(&doorIt, &i)) {
           if (CheckCollisionCircleRec(xPos, player->radius, currentLevel->doors[i].rect)) {
             if (myLevel < currentLevel->doors[i].requiredPerm) {
               blocked_x = true;
@@ -91,30 +97,22 @@ void UpdatePlayer(Entity *player, Level *currentLevel, float dt, bool godMode) {
     }
 
     // Check Enemy Collision (X)
-    for (int i = 0; i < currentLevel->enemyCount; i++) {
-        if (!currentLevel->enemies[i].active) continue;
-        if (CheckCollisionCircles(newPos, player->radius, currentLevel->enemies[i].position, currentLevel->enemies[i].radius)) {
-            // Revert X change if colliding with enemy
-            newPos.x = player->position.x; 
-            break;
-        }
+    if (HitsEnemy(currentLevel, enemyGrid, newPos, player->radius)) {
+        // Revert X change if colliding with enemy
+        newPos.x = player->position.x;
     }
 
     // --- Y AXIS ---
     Vector2 yPos = newPos;
     yPos.y += delta.y;
 
-    bool blocked_y = false;
-    for (int i = 0; i < currentLevel->wallCount; i++) {
-      if (CheckCollisionCircleRotatedRect(yPos, player->radius, currentLevel->walls[i].rect, currentLevel->walls[i].rotation)) {
-        blocked_y = true;
-        break;
-      }
-    }
+    bool blocked_y = Gameplay_CircleHitsWall(currentLevel, yPos, player->radius);
 
     if (!godMode) {
         PermissionLevel myLevel = player->inventory.card.level;
-        for (int i = 0; i < currentLevel->doorCount && !blocked_y; i++) {
+        LevelGridIter doorIt = LevelGrid_Query(&currentLevel->grid, GRID_LAYER_DOORS, Gameplay_CircleBounds(yPos, player->radius));
+        int i;
+        while (!blocked_y && LevelGridIter_Next(&doorIt, &i)) {
           if (CheckCollisionCircleRec(yPos, player->radius, currentLevel->doors[i].rect)) {
             if (myLevel < currentLevel->doors[i].requiredPerm) {
               blocked_y = true;
@@ -128,15 +126,11 @@ void UpdatePlayer(Entity *player, Level *currentLevel, float dt, bool godMode) {
     }
 
     // Check Enemy Collision (Y)
-    for (int i = 0; i < currentLevel->enemyCount; i++) {
-        if (!currentLevel->enemies[i].active) continue;
-        if (CheckCollisionCircles(newPos, player->radius, currentLevel->enemies[i].position, currentLevel->enemies[i].radius)) {
-            // Revert Y change if colliding with enemy
-            newPos.y = player->position.y; // Note: player->position.y is the original Y (since we haven't updated player->position yet)
-            // Wait, newPos.x might have changed from the X step. We only want to revert Y.
-            // If we revert to player->position.y, that is correct (Keep X change, revert Y change).
-            break;
-        }
+    if (HitsEnemy(currentLevel, enemyGrid, newPos, player->radius)) {
+        // Revert Y change if colliding with enemy
+        newPos.y = player->position.y; // Note: player->position.y is the original Y (since we haven't updated player->position yet)
+        // Wait, newPos.x might have changed from the X step. We only want to revert Y.
+        // If we revert to player->position.y, that is correct (Keep X change, revert Y change).
     }
 
     player->position = newPos;
@@ -2,6 +2,7 @@
 #include "../../raylib/src/raylib.h"
 #include "../entity.h"
 #include "../levels.h"
+#include "../entity_grid.h"
 #include "../types.h"
 
 #ifndef PLAYER_H
@@ -11,7 +12,7 @@
 Entity InitPlayer(Vector2 spawnPos, Identity startIdentity);
 
 // Update player movement and physics
-// Update player movement and physics
-void UpdatePlayer(Entity *player, Level *currentLevel, float dt, bool godMode);
+// `enemyGrid` bins currentLevel->enemyBodies, the player can't walk into them
+void UpdatePlayer(Entity *player, Level *currentLevel, const EntityGrid *enemyGrid, float dt, bool godMode);
 
 #endif // PLAYER_H
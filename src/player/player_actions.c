@@ -8,10 +8,10 @@ int PlayerActions_GetClosestEnemyInRange(const Level *level, Vector2 position, f
     float closestDist = range;
     int closestIndex = -1;
     for (int i = 0; i < level->enemyCount; i++) {
-        if (!level->enemies[i].active) {
+        if (!level->enemyBodies[i].active) {
             continue;
         }
-        float dist = Vector2Distance(position, level->enemies[i].position);
+        float dist = Vector2Distance(position, level->enemyBodies[i].position);
         if (dist <= closestDist) {
             closestDist = dist;
             closestIndex = i;
@@ -23,90 +23,70 @@ int PlayerActions_GetClosestEnemyInRange(const Level *level, Vector2 position, f
 void PlayerActions_HandleEnemyKilled(Level *level,
                                     int enemyIndex,
                                     Entity *player,
-                                    Entity *droppedMasks,
-                                    int maxMasks,
-                                    float droppedMaskRadius,
-                                    Entity *droppedCards,
-                                    int maxCards,
-                                    DroppedGun *droppedGuns,
-                                    int maxDroppedGuns) {
-    if (!level || !player || !droppedMasks) return;
+                                    PickupStore *pickups,
+                                    float droppedMaskRadius) {
+    if (!level || !player || !pickups) return;
     if (enemyIndex < 0 || enemyIndex >= level->enemyCount) {
         return;
     }
-    if (!level->enemies[enemyIndex].active) {
+    if (!level->enemyBodies[enemyIndex].active) {
         return;
     }
 
-    level->enemies[enemyIndex].active = false;
+    level->enemyBodies[enemyIndex].active = false;
 
     // Check if enemy has a mask to drop
-    if (level->enemies[enemyIndex].haveMask) {
-        // Find first inactive mask slot
-        for (int i = 0; i < maxMasks; i++) {
-            if (!droppedMasks[i].active) {
-                droppedMasks[i].identity = level->enemies[enemyIndex].identity;
-                droppedMasks[i].position = Vector2Add(level->enemies[enemyIndex].position, (Vector2){-15, -15});
-                droppedMasks[i].radius = droppedMaskRadius;
-                droppedMasks[i].active = true;
-                break;
-            }
+    if (level->enemyStats[enemyIndex].haveMask) {
+        Vector2 position = Vector2Add(level->enemyBodies[enemyIndex].position, (Vector2){-15, -15});
+        Pickup *mask = Pickups_Add(pickups, PICKUP_MASK, position, droppedMaskRadius);
+        if (mask) {
+            mask->maskColor = level->enemyAI[enemyIndex].identity.color;
         }
     }
     
     // Drop Permission Card logic
     // Check if enemy has a permission level
-    PermissionLevel enemyPerm = level->enemies[enemyIndex].identity.permissionLevel;
-    if (enemyPerm > PERM_NONE && droppedCards != 0) {
-        for (int i = 0; i < maxCards; i++) {
-             if (!droppedCards[i].active) {
-                 droppedCards[i].active = true;
-                 droppedCards[i].position = Vector2Add(level->enemies[enemyIndex].position, (Vector2){15, -15});
-                 droppedCards[i].radius = 10.0f; // Slightly smaller?
-                 droppedCards[i].identity.permissionLevel = enemyPerm;
-                 droppedCards[i].identity.color = level->enemies[enemyIndex].identity.color; // Match enemy color
-                 break;
-             }
+    PermissionLevel enemyPerm = level->enemyAI[enemyIndex].identity.permissionLevel;
+    if (enemyPerm > PERM_NONE) {
+        Vector2 position = Vector2Add(level->enemyBodies[enemyIndex].position, (Vector2){15, -15});
+        Pickup *card = Pickups_Add(pickups, PICKUP_CARD, position, 10.0f); // Slightly smaller?
+        if (card) {
+             card->card.level = enemyPerm;
+             card->card.color = level->enemyAI[enemyIndex].identity.color; // Match enemy color
         }
     }
 
     // Drop Gun Logic
     GunType dropType = GUN_NONE;
-    PermissionLevel pLevel = level->enemies[enemyIndex].identity.permissionLevel;
+    PermissionLevel pLevel = level->enemyAI[enemyIndex].identity.permissionLevel;
     
     if (pLevel == PERM_GUARD) dropType = GUN_HANDGUN;
     else if (pLevel == PERM_ADMIN) dropType = GUN_RIFLE;
     
-    if (dropType != GUN_NONE && droppedGuns != 0) {
-         for (int i = 0; i < maxDroppedGuns; i++) {
-             if (!droppedGuns[i].active) {
-                 droppedGuns[i].active = true;
-                 droppedGuns[i].position = Vector2Add(level->enemies[enemyIndex].position, (Vector2){0, 15});
-                 droppedGuns[i].radius = 15.0f;
-                 
-                 // Initialize basic gun stats (should strictly come from a factory or define, but hardcoding for drop instance)
-                 droppedGuns[i].gun.type = dropType;
-                 droppedGuns[i].gun.active = true;
-                 // Fill ammo for pickup
-                 if (dropType == GUN_HANDGUN) {
-                     droppedGuns[i].gun.maxAmmo = 12; // Example
-                     droppedGuns[i].gun.currentAmmo = 6; // Randomize?
-                     droppedGuns[i].gun.reserveAmmo = 12;
-                     droppedGuns[i].gun.reloadTime = 1.5f;
-                     droppedGuns[i].gun.cooldown = 0.5f;
-                     droppedGuns[i].gun.damage = 30.0f;
-                     droppedGuns[i].gun.range = 300.0f;
-                 } else if (dropType == GUN_RIFLE) {
-                     droppedGuns[i].gun.maxAmmo = 30;
-                     droppedGuns[i].gun.currentAmmo = 15;
-                     droppedGuns[i].gun.reserveAmmo = 30;
-                     droppedGuns[i].gun.reloadTime = 2.0f;
-                     droppedGuns[i].gun.cooldown = 0.1f;
-                     droppedGuns[i].gun.damage = 35.0f;
-                     droppedGuns[i].gun.range = 500.0f;
-                 }
-                 break;
-             }
+    Vector2 gunPosition = Vector2Add(level->enemyBodies[enemyIndex].position, (Vector2){0, 15});
+    Pickup *drop = (dropType != GUN_NONE) ? Pickups_Add(pickups, PICKUP_GUN, gunPosition, 15.0f) : NULL;
+    if (drop) {
+         
+         // Initialize basic gun stats (should strictly come from a factory or define, but hardcoding for drop instance)
+         drop->gun.type = dropType;
+         drop->gun.active = true;
+         // Fill ammo for pickup
+         if (dropType == GUN_HANDGUN) {
+             drop->gun.maxAmmo = 12; // Example
+             drop->gun.currentAmmo = 6; // Randomize?
+             drop->gun.reserveAmmo = 12;
+             drop->gun.reloadTime = 1.5f;
+             drop->gun.cooldown = 0.5f;
+             drop->gun.damage = 30.0f;
+             drop->gun.range = 300.0f;
+         } else if (dropType == GUN_RIFLE) {
+             drop->gun.maxAmmo = 30;
+             drop->gun.currentAmmo = 15;
+             drop->gun.reserveAmmo = 30;
+             drop->gun.reloadTime = 2.0f;
+             drop->gun.cooldown = 0.1f;
+             drop->gun.damage = 35.0f;
+             drop->gun.range = 500.0f;
          }
     }
 
@@ -128,26 +108,21 @@ void PlayerActions_ApplyDamage(Level *level,
                                int enemyIndex, 
                                float damage,
                                Entity *player,
-                               Entity *droppedMasks,
-                               int maxMasks,
-                               float droppedMaskRadius,
-                               Entity *droppedCards,
-                               int maxCards,
-                               DroppedGun *droppedGuns,
-                               int maxDroppedGuns) {
+                               PickupStore *pickups,
+                               float droppedMaskRadius) {
     if (enemyIndex < 0 || enemyIndex >= level->enemyCount) return;
-    if (!level->enemies[enemyIndex].active) return;
+    if (!level->enemyBodies[enemyIndex].active) return;
 
-    level->enemies[enemyIndex].health -= damage;
+    level->enemyStats[enemyIndex].health -= damage;
     
     // Feedback? (Flash white, sound, particles?)
     
-    if (level->enemies[enemyIndex].health <= 0) {
-        PlayerActions_HandleEnemyKilled(level, enemyIndex, player, droppedMasks, maxMasks, droppedMaskRadius, droppedCards, maxCards, droppedGuns, maxDroppedGuns);
+    if (level->enemyStats[enemyIndex].health <= 0) {
+        PlayerActions_HandleEnemyKilled(level, enemyIndex, player, pickups, droppedMaskRadius);
     } else {
 
         // SURVIVED: Reaction Logic
-        Entity *enemy = &level->enemies[enemyIndex];
+        EnemyAI *enemy = &level->enemyAI[enemyIndex];
         
         // 1. Alert the enemy
         enemy->lastKnownPlayerPos = player->position;
@@ -7,32 +7,24 @@
 
 #include "../entity.h"
 #include "../levels.h"
+#include "../pickups.h"
 
 // Player-driven gameplay actions (combat/interaction helpers).
+// Killed enemies drop their mask, keycard and gun into `pickups`.
 
 int PlayerActions_GetClosestEnemyInRange(const Level *level, Vector2 position, float range);
 
 void PlayerActions_HandleEnemyKilled(Level *level,
                                     int enemyIndex,
                                     Entity *player,
-                                    Entity *droppedMasks,
-                                    int maxMasks,
-                                    float droppedMaskRadius,
-                                    Entity *droppedCards,
-                                    int maxCards,
-                                    DroppedGun *droppedGuns,
-                                    int maxDroppedGuns);
+                                    PickupStore *pickups,
+                                    float droppedMaskRadius);
 
 void PlayerActions_ApplyDamage(Level *level, 
                                int enemyIndex, 
                                float damage,
                                Entity *player,
-                               Entity *droppedMasks,
-                               int maxMasks,
-                               float droppedMaskRadius,
-                               Entity *droppedCards,
-                               int maxCards,
-                               DroppedGun *droppedGuns,
-                               int maxDroppedGuns);
+                               PickupStore *pickups,
+                               float droppedMaskRadius);
 
 #endif // PLAYER_ACTIONS_H
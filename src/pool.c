@@ -0,0 +1,39 @@
+#include "pool.h"
+#include "../raylib/src/raylib.h"
+#include <stdlib.h>
+#include <string.h>
+
+void *Pool_Acquire(Pool *pool) {
+    if (pool->maxCount > 0 && pool->count >= pool->maxCount) return NULL;
+    if (pool->count == pool->capacity) {
+        int capacity = (pool->capacity > 0) ? pool->capacity * 2 : POOL_INITIAL_CAPACITY;
+        if (pool->maxCount > 0 && capacity > pool->maxCount) capacity = pool->maxCount;
+        void *items = realloc(pool->items, pool->elemSize * (size_t)capacity);
+        if (!items) {
+            TraceLog(LOG_WARNING, "Failed to grow pool to %d", capacity);
+            return NULL;
+        }
+        pool->items = items;
+        pool->capacity = capacity;
+    }
+
+    void *item = Pool_At(pool, pool->count++);
+    memset(item, 0, pool->elemSize);
+    return item;
+}
+
+void Pool_Release(Pool *pool, int index) {
+    pool->count--;
+    if (index != pool->count) memcpy(Pool_At(pool, index), Pool_At(pool, pool->count), pool->elemSize);
+}
+
+void Pool_Clear(Pool *pool) {
+    pool->count = 0;
+}
+
+void Pool_Free(Pool *pool) {
+    free(pool->items);
+    pool->items = NULL;
+    pool->count = 0;
+    pool->capacity = 0;
+}
@@ -0,0 +1,41 @@
+#ifndef POOL_H
+#define POOL_H
+
+#include <stddef.h>
+
+// Growable pool of same-size elements (bullets, particles, drops).
+// Live elements are kept packed in items[0 .. count): acquiring appends, releasing
+// moves the last element into the freed slot, so both are O(1) and loops only touch
+// live elements. Releasing reorders the pool; loops that release should not advance
+// past the refilled slot (or walk the pool backwards).
+
+#define POOL_INITIAL_CAPACITY 64
+
+typedef struct {
+    void *items;
+    size_t elemSize;
+    int count;
+    int capacity;
+    int maxCount; // Acquire fails once this many are live (0: no limit)
+} Pool;
+
+// Initializer for an empty pool of `type`
+#define POOL_INIT(type, max) { .elemSize = sizeof(type), .maxCount = (max) }
+
+// Returns a zeroed element at the end of the pool, growing it if needed
+// (NULL if the pool is full or out of memory)
+void *Pool_Acquire(Pool *pool);
+
+void Pool_Release(Pool *pool, int index);
+
+static inline void *Pool_At(const Pool *pool, int index) {
+    return (char *)pool->items + (size_t)index * pool->elemSize;
+}
+
+// Drops all elements but keeps the storage
+void Pool_Clear(Pool *pool);
+
+// Frees the storage, the pool stays usable (and empty)
+void Pool_Free(Pool *pool);
+
+#endif // POOL_H
@@ -0,0 +1,44 @@
+#include "rng.h"
+
+#define RNG_BASE_SEED 0x853c49e6748fea9bULL
+#define RNG_MULTIPLIER 6364136223846793005ULL
+
+// splitmix64 finalizer, spreads nearby episode numbers over the whole seed space
+static uint64_t Mix(uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+uint64_t Rng_LevelSeed(int episode) {
+    return Mix(RNG_BASE_SEED ^ (uint64_t)(uint32_t)episode);
+}
+
+void Rng_Seed(Rng *rng, uint64_t seed, RngSystem system, uint32_t index) {
+    uint64_t stream = ((uint64_t)system << 32) | index;
+    rng->state = 0;
+    rng->inc = (stream << 1) | 1u;
+    Rng_Next(rng);
+    rng->state += seed;
+    Rng_Next(rng);
+}
+
+uint32_t Rng_Next(Rng *rng) {
+    uint64_t old = rng->state;
+    rng->state = old * RNG_MULTIPLIER + rng->inc;
+    uint32_t xorshifted = (uint32_t)(((old >> 18) ^ old) >> 27);
+    uint32_t rot = (uint32_t)(old >> 59);
+    return (xorshifted >> rot) | (xorshifted << ((32 - rot) & 31));
+}
+
+int Rng_Range(Rng *rng, int min, int max) {
+    if (max < min) {
+        int t = min;
+        min = max;
+        max = t;
+    }
+    // Scale instead of modulo: no division, and the bias is below 2^-32 per value
+    uint64_t span = (uint64_t)((int64_t)max - min) + 1;
+    return (int)((int64_t)min + (int64_t)(((uint64_t)Rng_Next(rng) * span) >> 32));
+}
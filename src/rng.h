@@ -0,0 +1,34 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <stdint.h>
+
+// Seeded random streams (PCG32) replacing raylib's global GetRandomValue in gameplay.
+// Every level has a seed derived from its episode; each system, and each entity
+// within a system, draws from its own stream of that seed. Streams don't depend on
+// each other or on update order, so a level replays identically, serial or parallel.
+
+typedef struct {
+    uint64_t state;
+    uint64_t inc; // Stream selector (odd)
+} Rng;
+
+// Stream families; the index picks the stream within one (e.g. the enemy index)
+typedef enum {
+    RNG_STREAM_SPAWN = 0, // Level setup
+    RNG_STREAM_ENEMY_AI,  // One per enemy
+    RNG_STREAM_EFFECTS    // Blood and other cosmetics
+} RngSystem;
+
+// Seed of the level of `episode`
+uint64_t Rng_LevelSeed(int episode);
+
+// Starts stream `index` of `system` under `seed`
+void Rng_Seed(Rng *rng, uint64_t seed, RngSystem system, uint32_t index);
+
+uint32_t Rng_Next(Rng *rng);
+
+// Random integer in [min, max], like GetRandomValue
+int Rng_Range(Rng *rng, int min, int max);
+
+#endif // RNG_H
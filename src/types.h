@@ -66,13 +66,6 @@ typedef struct {
   bool active;        // Does this slot have a gun?
 } Gun;
 
-typedef struct {
-    Vector2 position;
-    float radius;
-    bool active;
-    Gun gun;
-} DroppedGun;
-
 // --- MASK SYSTEM ---
 typedef enum {
   MASK_NONE = 0,
@@ -0,0 +1,436 @@
+#include "visibility.h"
+#include "../raylib/src/raymath.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Sweep sizes for a level of `boxes` walls and doors
+#define VIS_MAX_SEGMENTS(boxes) ((boxes) * 4)
+#define VIS_MAX_INTERVALS(boxes) (VIS_MAX_SEGMENTS(boxes) * 2)
+#define VIS_MAX_EVENTS(boxes) (VIS_MAX_INTERVALS(boxes) * 2 + VIS_MAX_SEGMENTS(boxes) * 2 + VISIBILITY_ARC_SEGMENTS + 2)
+
+// Angular range [lo, hi] (relative to the cone start) covered by one occluder edge
+typedef struct {
+    float lo, hi;
+    int segment;
+} VisInterval;
+
+// Sweep stop: angle relative to the cone start and the matching unit direction,
+// taken from the geometry that caused it so the sweep needs no trig per event
+typedef struct {
+    float angle;
+    Vector2 dir;
+} VisEvent;
+
+// Scratch for the sweep, reused between calls and grown with the level (only built on the main thread)
+static int scratchBoxes; // Walls + doors the scratch is sized for
+static Vector2 *segA;
+static Vector2 *segB;
+static VisInterval *intervals;
+static VisEvent *events;
+static int *active;
+static bool *seen; // Per wall then per door, already gathered by this sweep
+
+static bool ReserveScratch(int boxes) {
+    if (boxes < 1) boxes = 1; // The arc events need room even without walls
+    if (boxes <= scratchBoxes) return true;
+    if (boxes < scratchBoxes * 2) boxes = scratchBoxes * 2;
+
+    Vector2 *a = realloc(segA, sizeof(Vector2) * (size_t)VIS_MAX_SEGMENTS(boxes));
+    if (a) segA = a;
+    Vector2 *b = realloc(segB, sizeof(Vector2) * (size_t)VIS_MAX_SEGMENTS(boxes));
+    if (b) segB = b;
+    VisInterval *iv = realloc(intervals, sizeof(VisInterval) * (size_t)VIS_MAX_INTERVALS(boxes));
+    if (iv) intervals = iv;
+    VisEvent *ev = realloc(events, sizeof(VisEvent) * (size_t)VIS_MAX_EVENTS(boxes));
+    if (ev) events = ev;
+    int *ac = realloc(active, sizeof(int) * (size_t)VIS_MAX_INTERVALS(boxes));
+    if (ac) active = ac;
+    bool *se = realloc(seen, sizeof(bool) * (size_t)boxes);
+    if (se) seen = se;
+    if (!a || !b || !iv || !ev || !ac || !se) {
+        TraceLog(LOG_WARNING, "Failed to grow visibility scratch to %d walls and doors", boxes);
+        return false;
+    }
+    scratchBoxes = boxes;
+    return true;
+}
+
+static float WrapAngle(float a) {
+    a = fmodf(a, 2.0f * PI);
+    if (a < 0.0f) a += 2.0f * PI;
+    return a;
+}
+
+static int CompareEvents(const void *a, const void *b) {
+    float fa = ((const VisEvent *)a)->angle, fb = ((const VisEvent *)b)->angle;
+    return (fa > fb) - (fa < fb);
+}
+
+static int CompareIntervals(const void *a, const void *b) {
+    float la = ((const VisInterval *)a)->lo, lb = ((const VisInterval *)b)->lo;
+    return (la > lb) - (la < lb);
+}
+
+// Distance from origin along dir to the line through segment s
+static float RayDistance(Vector2 origin, Vector2 dir, int s) {
+    Vector2 e = Vector2Subtract(segB[s], segA[s]);
+    Vector2 w = Vector2Subtract(segA[s], origin);
+    float denom = dir.x * e.y - dir.y * e.x;
+    if (fabsf(denom) < 1e-9f) return fminf(Vector2Length(w), Vector2Distance(origin, segB[s]));
+    return (w.x * e.y - w.y * e.x) / denom;
+}
+
+// Crossing of the lines through segments s and t, as a sweep event plus distance.
+// Returns false if they are parallel.
+static bool SegmentCrossing(const VisibilityPolygon *poly, int s, int t, VisEvent *ev, float *dist) {
+    Vector2 e = Vector2Subtract(segB[s], segA[s]);
+    Vector2 f = Vector2Subtract(segB[t], segA[t]);
+    float denom = e.x * f.y - e.y * f.x;
+    if (fabsf(denom) < 1e-9f) return false;
+
+    Vector2 w = Vector2Subtract(segA[t], segA[s]);
+    float u = (w.x * f.y - w.y * f.x) / denom;
+    Vector2 v = Vector2Subtract(Vector2Add(segA[s], Vector2Scale(e, u)), poly->origin);
+    *dist = Vector2Length(v);
+    if (*dist < 1e-6f) return false;
+    ev->angle = WrapAngle(atan2f(v.y, v.x) - poly->startAngle);
+    ev->dir = Vector2Scale(v, 1.0f / *dist);
+    return true;
+}
+
+static void AddSegment(int *count, Vector2 a, Vector2 b, Vector2 origin, float range) {
+    // Drop edges entirely beyond the range
+    Vector2 e = Vector2Subtract(b, a);
+    float len2 = Vector2LengthSqr(e);
+    float u = (len2 > 0.0f) ? Clamp(Vector2DotProduct(Vector2Subtract(origin, a), e) / len2, 0.0f, 1.0f) : 0.0f;
+    Vector2 closest = Vector2Add(a, Vector2Scale(e, u));
+    if (Vector2DistanceSqr(origin, closest) > range * range) return;
+
+    segA[*count] = a;
+    segB[*count] = b;
+    (*count)++;
+}
+
+// Corners in box order (local -x-y, +x-y, +x+y, -x+y). Only edges facing the origin can be
+// the nearest hit; if none do, the origin is inside the box and every edge is kept (rays stop at the exit).
+static void AddBoxSegments(int *count, const Vector2 c[4], Vector2 origin, float range) {
+    bool facing[4];
+    bool any = false;
+    for (int k = 0; k < 4; k++) {
+        Vector2 a = c[k], b = c[(k + 1) % 4];
+        facing[k] = (b.x - a.x) * (origin.y - a.y) - (b.y - a.y) * (origin.x - a.x) < 0.0f;
+        any = any || facing[k];
+    }
+    for (int k = 0; k < 4; k++) {
+        if (facing[k] || !any) AddSegment(count, c[k], c[(k + 1) % 4], origin, range);
+    }
+}
+
+static void EmitPoint(VisibilityPolygon *poly, const VisEvent *ev, float dist) {
+    Vector2 p = Vector2Add(poly->origin, Vector2Scale(ev->dir, dist));
+
+    // Skip repeats (edges meeting at a corner report the same point twice)
+    if (poly->pointCount > 0 && Vector2DistanceSqr(p, poly->points[poly->pointCount - 1]) < 1e-6f) return;
+    if (poly->pointCount >= VISIBILITY_MAX_POINTS) {
+        poly->complete = false;
+        return;
+    }
+
+    poly->points[poly->pointCount] = p;
+    poly->angles[poly->pointCount] = ev->angle;
+    poly->pointCount++;
+}
+
+void Visibility_Compute(VisibilityPolygon *poly, const Level *level, Vector2 origin,
+                        float rotation, float coneAngle, float range) {
+    poly->origin = origin;
+    poly->span = fminf(coneAngle, 360.0f) * DEG2RAD;
+    poly->startAngle = rotation * DEG2RAD - poly->span / 2.0f;
+    poly->range = range;
+    poly->viewStart = 0.0f;
+    poly->viewSpan = poly->span;
+    poly->valid = false;
+    poly->complete = false;
+    poly->pointCount = 0;
+    if (!ReserveScratch(level->wallCount + level->doorCount)) return;
+    poly->complete = true;
+    if (range <= 0.0f || poly->span <= 0.0f) return;
+
+    // 1. Gather edges of walls and closed doors near the origin
+    Rectangle area = { origin.x - range, origin.y - range, range * 2.0f, range * 2.0f };
+    int segmentCount = 0;
+    if (level->wallCount > 0) memset(seen, 0, sizeof(bool) * (size_t)level->wallCount);
+    int i;
+
+    for (int layer = GRID_LAYER_AABB_WALLS; layer <= GRID_LAYER_OBB_WALLS; layer++) {
+        LevelGridIter it = LevelGrid_Query(&level->grid, (GridLayer)layer, area);
+        while (LevelGridIter_Next(&it, &i)) {
+            if (seen[i]) continue;
+            seen[i] = true;
+
+            const WallShape *w = &level->wallShapes[i];
+            Vector2 ex = Vector2Scale(w->axisX, w->halfExtents.x);
+            Vector2 ey = Vector2Scale(w->axisY, w->halfExtents.y);
+            Vector2 c[4] = {
+                Vector2Subtract(Vector2Subtract(w->center, ex), ey),
+                Vector2Subtract(Vector2Add(w->center, ex), ey),
+                Vector2Add(Vector2Add(w->center, ex), ey),
+                Vector2Add(Vector2Subtract(w->center, ex), ey)
+            };
+            AddBoxSegments(&segmentCount, c, origin, range);
+        }
+    }
+
+    // Doors in range are recorded whether open or not, flipping any of them changes the view
+    bool *seenDoor = seen + level->wallCount;
+    if (level->doorCount > 0) memset(seenDoor, 0, sizeof(bool) * (size_t)level->doorCount);
+    poly->doorCount = 0;
+    poly->doorStamp = Level_DoorStamp(level);
+    LevelGridIter doorIt = LevelGrid_Query(&level->grid, GRID_LAYER_DOORS, area);
+    while (LevelGridIter_Next(&doorIt, &i)) {
+        if (seenDoor[i]) continue;
+        seenDoor[i] = true;
+
+        Rectangle r = level->doors[i].rect;
+        float dx = fmaxf(fmaxf(r.x - origin.x, 0.0f), origin.x - (r.x + r.width));
+        float dy = fmaxf(fmaxf(r.y - origin.y, 0.0f), origin.y - (r.y + r.height));
+        if (dx * dx + dy * dy > range * range) continue;
+        if (poly->doorCount == VISIBILITY_MAX_DOORS) {
+            poly->doorCount = -1; // Falls back to doorStamp
+        } else if (poly->doorCount >= 0) {
+            poly->doors[poly->doorCount] = i;
+            poly->doorVersions[poly->doorCount] = level->doorVersions[i];
+            poly->doorCount++;
+        }
+        if (level->doors[i].isOpen) continue;
+
+        Vector2 c[4] = {
+            { r.x, r.y }, { r.x + r.width, r.y },
+            { r.x + r.width, r.y + r.height }, { r.x, r.y + r.height }
+        };
+        AddBoxSegments(&segmentCount, c, origin, range);
+    }
+
+    // 2. Angular interval of each edge, clipped to the cone (split where it wraps past the start).
+    // Its ends are sweep events, as are the points where it crosses the range circle.
+    Vector2 coneStart = { cosf(poly->startAngle), sinf(poly->startAngle) };
+    Vector2 coneEnd = { cosf(poly->startAngle + poly->span), sinf(poly->startAngle + poly->span) };
+    int intervalCount = 0;
+    int eventCount = 0;
+    for (int s = 0; s < segmentCount; s++) {
+        Vector2 va = Vector2Subtract(segA[s], origin);
+        Vector2 vb = Vector2Subtract(segB[s], origin);
+        float width = atan2f(va.x * vb.y - va.y * vb.x, Vector2DotProduct(va, vb));
+        if (fabsf(width) < 1e-6f) continue; // Edge points at the origin, blocks nothing
+
+        Vector2 first = va, last = vb;
+        float lo = WrapAngle(atan2f(va.y, va.x) - poly->startAngle);
+        if (width < 0.0f) {
+            lo = WrapAngle(lo + width);
+            width = -width;
+            first = vb;
+            last = va;
+        }
+        float hi = lo + width;
+        Vector2 firstDir = Vector2Normalize(first);
+        Vector2 lastDir = Vector2Normalize(last);
+
+        if (lo <= poly->span) {
+            intervals[intervalCount++] = (VisInterval){ lo, fminf(hi, poly->span), s };
+            events[eventCount++] = (VisEvent){ lo, firstDir };
+            events[eventCount++] = (hi <= poly->span) ? (VisEvent){ hi, lastDir } : (VisEvent){ poly->span, coneEnd };
+        }
+        if (hi > 2.0f * PI) {
+            float wrapped = hi - 2.0f * PI;
+            intervals[intervalCount++] = (VisInterval){ 0.0f, fminf(wrapped, poly->span), s };
+            events[eventCount++] = (VisEvent){ 0.0f, coneStart };
+            events[eventCount++] = (wrapped <= poly->span) ? (VisEvent){ wrapped, lastDir } : (VisEvent){ poly->span, coneEnd };
+        }
+
+        Vector2 e = Vector2Subtract(segB[s], segA[s]);
+        float qa = Vector2DotProduct(e, e);
+        float qb = Vector2DotProduct(va, e);
+        float qc = Vector2DotProduct(va, va) - range * range;
+        float disc = qb * qb - qa * qc;
+        if (qa > 0.0f && disc > 0.0f) {
+            float root = sqrtf(disc);
+            for (int k = -1; k <= 1; k += 2) {
+                float u = (-qb + k * root) / qa;
+                if (u <= 0.0f || u >= 1.0f) continue;
+                Vector2 p = Vector2Add(va, Vector2Scale(e, u));
+                float a = WrapAngle(atan2f(p.y, p.x) - poly->startAngle);
+                if (a <= poly->span) events[eventCount++] = (VisEvent){ a, Vector2Scale(p, 1.0f / range) };
+            }
+        }
+    }
+
+    // 3. Arc subdivisions (also the cone edges), then sort everything by angle
+    for (int k = 0; k <= VISIBILITY_ARC_SEGMENTS; k++) {
+        float a = poly->span * (float)k / VISIBILITY_ARC_SEGMENTS;
+        events[eventCount++] = (VisEvent){ a, { cosf(poly->startAngle + a), sinf(poly->startAngle + a) } };
+    }
+    qsort(events, eventCount, sizeof(VisEvent), CompareEvents);
+    qsort(intervals, intervalCount, sizeof(VisInterval), CompareIntervals);
+
+    // 4. Sweep. At each event, the nearest edge just before and just after it gives
+    // the boundary; a vertex is only needed where that edge changes (or on the arc).
+    int activeCount = 0;
+    int nextInterval = 0;
+    float lastEvent = -1.0f;
+    int lastSeg = -1;
+    for (int n = 0; n < eventCount; n++) {
+        const VisEvent *ev = &events[n];
+        float a = ev->angle;
+        if (a == lastEvent) continue;
+        lastEvent = a;
+
+        while (nextInterval < intervalCount && intervals[nextInterval].lo <= a) {
+            active[activeCount++] = nextInterval++;
+        }
+
+        float distBefore = range, distAfter = range;
+        int segBefore = -1, segAfter = -1;
+        for (int k = 0; k < activeCount; ) {
+            const VisInterval *iv = &intervals[active[k]];
+            if (iv->hi < a) {
+                active[k] = active[--activeCount]; // Swept past it
+                continue;
+            }
+            float d = RayDistance(origin, ev->dir, iv->segment);
+            if (d >= 0.0f) {
+                if (iv->lo < a && d < distBefore) { distBefore = d; segBefore = iv->segment; }
+                if (iv->hi > a && d < distAfter) { distAfter = d; segAfter = iv->segment; }
+            }
+            k++;
+        }
+
+        // Overlapping walls: the nearest edge changed between events, where the two edges cross
+        VisEvent cross;
+        float crossDist;
+        if (n > 0 && segBefore != lastSeg && segBefore >= 0 && lastSeg >= 0 &&
+            SegmentCrossing(poly, lastSeg, segBefore, &cross, &crossDist) &&
+            cross.angle >= poly->angles[poly->pointCount - 1] && cross.angle <= a) {
+            EmitPoint(poly, &cross, crossDist);
+        }
+        lastSeg = segAfter;
+
+        if (n == 0) {
+            EmitPoint(poly, ev, distAfter);
+        } else if (a >= poly->span) {
+            EmitPoint(poly, ev, distBefore);
+            break;
+        } else if (segBefore != segAfter || segBefore < 0) {
+            EmitPoint(poly, ev, distBefore);
+            EmitPoint(poly, ev, distAfter);
+        }
+    }
+}
+
+static bool DoorsUnchanged(const VisibilityPolygon *poly, const Level *level) {
+    if (poly->doorCount < 0) return Level_DoorStamp(level) == poly->doorStamp;
+    for (int k = 0; k < poly->doorCount; k++) {
+        if (level->doorVersions[poly->doors[k]] != poly->doorVersions[k]) return false;
+    }
+    return true;
+}
+
+bool Visibility_Update(VisibilityPolygon *poly, const Level *level, Vector2 origin,
+                       float rotation, float coneAngle, float range) {
+    float cone = fminf(coneAngle, 360.0f);
+    bool fullCircle = cone >= 360.0f;
+
+    // Turn since the polygon was built, in [-180, 180)
+    float turn = fmodf(rotation - poly->builtRotation, 360.0f);
+    if (turn >= 180.0f) turn -= 360.0f;
+    else if (turn < -180.0f) turn += 360.0f;
+
+    bool reuse = poly->valid &&
+                 poly->staticVersion == level->staticVersion &&
+                 DoorsUnchanged(poly, level) &&
+                 poly->origin.x == origin.x && poly->origin.y == origin.y &&
+                 poly->range == range && poly->coneAngle == cone &&
+                 (fullCircle || fabsf(turn) <= poly->slack);
+
+    if (!reuse) {
+        float slack = fmaxf(fminf(VISIBILITY_ROTATION_SLACK, (360.0f - cone) / 2.0f), 0.0f);
+        Visibility_Compute(poly, level, origin, rotation, cone + slack * 2.0f, range);
+        poly->valid = poly->complete; // Else built again next time, sight falls back to raycasts
+        poly->staticVersion = level->staticVersion;
+        poly->builtRotation = rotation;
+        poly->coneAngle = cone;
+        poly->slack = slack;
+        turn = 0.0f;
+    }
+
+    if (!fullCircle) {
+        poly->viewSpan = cone * DEG2RAD;
+        poly->viewStart = Clamp((poly->slack + turn) * DEG2RAD, 0.0f, poly->span - poly->viewSpan);
+    }
+    return !reuse;
+}
+
+// Boundary edge k (points[k] -> points[k + 1]) spanning relative angle a.
+// Largest k with angles[k] <= a, skipping back over radial steps.
+static int FindBoundaryEdge(const VisibilityPolygon *poly, float a) {
+    int lo = 0, hi = poly->pointCount - 1;
+    while (hi - lo > 1) {
+        int mid = (lo + hi) / 2;
+        if (poly->angles[mid] <= a) lo = mid; else hi = mid;
+    }
+    int k = lo;
+    while (k > 0 && poly->angles[k + 1] <= poly->angles[k]) k--;
+    return k;
+}
+
+// Distance from the origin along unit `dir` to boundary edge k
+static float BoundaryDistance(const VisibilityPolygon *poly, int k, Vector2 dir) {
+    Vector2 p0 = poly->points[k];
+    Vector2 p1 = poly->points[k + 1];
+    float d0 = Vector2Distance(poly->origin, p0);
+    float d1 = Vector2Distance(poly->origin, p1);
+
+    // Arc chords stand for the range circle itself
+    if (d0 >= poly->range * 0.9999f && d1 >= poly->range * 0.9999f) return poly->range;
+
+    Vector2 e = Vector2Subtract(p1, p0);
+    Vector2 w = Vector2Subtract(p0, poly->origin);
+    float denom = dir.x * e.y - dir.y * e.x;
+    return (fabsf(denom) > 1e-9f) ? (w.x * e.y - w.y * e.x) / denom : fminf(d0, d1);
+}
+
+int Visibility_GetOutline(const VisibilityPolygon *poly, Vector2 *points, int maxPoints) {
+    if (poly->pointCount < 2 || maxPoints < 2) return 0;
+
+    float a0 = poly->viewStart;
+    float a1 = poly->viewStart + poly->viewSpan;
+    int count = 0;
+
+    Vector2 dir0 = { cosf(poly->startAngle + a0), sinf(poly->startAngle + a0) };
+    points[count++] = Vector2Add(poly->origin, Vector2Scale(dir0, BoundaryDistance(poly, FindBoundaryEdge(poly, a0), dir0)));
+
+    for (int k = 0; k < poly->pointCount && count < maxPoints - 1; k++) {
+        if (poly->angles[k] > a0 && poly->angles[k] < a1) points[count++] = poly->points[k];
+    }
+
+    Vector2 dir1 = { cosf(poly->startAngle + a1), sinf(poly->startAngle + a1) };
+    points[count++] = Vector2Add(poly->origin, Vector2Scale(dir1, BoundaryDistance(poly, FindBoundaryEdge(poly, a1), dir1)));
+    return count;
+}
+
+bool Visibility_ContainsPoint(const VisibilityPolygon *poly, Vector2 point) {
+    if (poly->pointCount < 2) return false;
+
+    Vector2 v = Vector2Subtract(point, poly->origin);
+    float distSq = Vector2LengthSqr(v);
+    if (distSq > poly->range * poly->range) return false;
+    if (distSq < 1e-6f) return true;
+
+    float a = WrapAngle(atan2f(v.y, v.x) - poly->startAngle);
+    if (a < poly->viewStart || a > poly->viewStart + poly->viewSpan) return false;
+
+    Vector2 dir = Vector2Scale(v, 1.0f / sqrtf(distSq));
+    float boundary = BoundaryDistance(poly, FindBoundaryEdge(poly, a), dir);
+
+    // Same tolerance as CheckLineOfSight's raycast: blocked only if the boundary is clearly closer
+    return !(boundary * boundary < distSq - 1.0f);
+}
@@ -0,0 +1,72 @@
+#ifndef VISIBILITY_H
+#define VISIBILITY_H
+
+#include "levels.h"
+
+// Visibility polygon of a vision cone: the exact region seen from `origin`
+// within `range` and the cone angle, with walls and closed doors as occluders.
+// Built by an angular sweep over occluder edges; the far arc (where nothing blocks)
+// is approximated by VISIBILITY_ARC_SEGMENTS chords over the cone.
+
+#define VISIBILITY_MAX_POINTS 512
+#define VISIBILITY_ARC_SEGMENTS 30
+
+// Visibility_Update builds the cone this many degrees wider on each side, so an
+// enemy turning by less than that reuses the polygon
+#define VISIBILITY_ROTATION_SLACK 15.0f
+
+// Doors within range a polygon keeps versions of. With more than that in range it
+// is rebuilt when any door of the level changes.
+#define VISIBILITY_MAX_DOORS 16
+
+typedef struct {
+    Vector2 origin;
+    float startAngle; // Radians, cone start
+    float span;       // Radians, cone width (up to 2*PI)
+    float range;
+
+    // Part of the built cone currently looked at, relative to startAngle
+    float viewStart;
+    float viewSpan;
+
+    // Cache key, see Visibility_Update
+    bool valid;
+    unsigned int staticVersion;
+    int doorCount;                                  // Doors within range when built (open or not), -1 if too many
+    int doors[VISIBILITY_MAX_DOORS];
+    unsigned int doorVersions[VISIBILITY_MAX_DOORS]; // Their versions when built
+    unsigned int doorStamp;                         // Level_DoorStamp when built, checked instead if doorCount is -1
+    float builtRotation; // Degrees
+    float coneAngle;     // Degrees, the requested cone (without slack)
+    float slack;         // Degrees added on each side when built
+
+    // Boundary, ordered by angle from the cone start. The polygon is the fan
+    // origin -> points[k] -> points[k + 1]. angles[k] is relative to startAngle.
+    // Not complete when it needed more than VISIBILITY_MAX_POINTS points or the sweep
+    // scratch could not grow: the boundary past the last point is then unknown.
+    bool complete;
+    int pointCount;
+    Vector2 points[VISIBILITY_MAX_POINTS];
+    float angles[VISIBILITY_MAX_POINTS];
+} VisibilityPolygon;
+
+// rotation / coneAngle in degrees, like Entity.rotation and Entity.sightAngle
+void Visibility_Compute(VisibilityPolygon *poly, const Level *level, Vector2 origin,
+                        float rotation, float coneAngle, float range);
+
+// Cached version of Visibility_Compute. Keeps the polygon while origin, range, cone angle,
+// the level's static geometry and the doors within range are unchanged, and rotation stays
+// within VISIBILITY_ROTATION_SLACK of the pose it was built for; only the view is moved then.
+// An incomplete polygon is not kept (built again next call). Returns true if it rebuilt.
+bool Visibility_Update(VisibilityPolygon *poly, const Level *level, Vector2 origin,
+                       float rotation, float coneAngle, float range);
+
+// Boundary of the current view from the cone start to the cone end (up to VISIBILITY_MAX_POINTS + 2).
+// Fanned from poly->origin it covers exactly the visible region.
+int Visibility_GetOutline(const VisibilityPolygon *poly, Vector2 *points, int maxPoints);
+
+// True if `point` is inside the polygon (same 1px tolerance as the raycast line of sight).
+// Only meaningful for a complete polygon.
+bool Visibility_ContainsPoint(const VisibilityPolygon *poly, Vector2 point);
+
+#endif // VISIBILITY_H